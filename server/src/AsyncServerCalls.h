@@ -0,0 +1,258 @@
+#ifndef UNITTESTBOT_ASYNCSERVERCALLS_H
+#define UNITTESTBOT_ASYNCSERVERCALLS_H
+
+#include "RequestEnvironment.h"
+#include "exceptions/CancellationException.h"
+
+#include "loguru.h"
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/impl/codegen/async_stream.h>
+#include <grpcpp/impl/codegen/async_unary_call.h>
+#include <grpcpp/impl/codegen/sync_stream.h>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <utility>
+
+namespace utbot {
+    /**
+     * Runs handler of a matched call on a worker thread. Handlers are never run on the thread
+     * that polls completion queue: they may log to a log channel, and its writes wait for
+     * that thread.
+     */
+    using CallExecutor = std::function<void(std::function<void()>)>;
+
+    /**
+     * Tag of an operation on a completion queue. The polling thread calls it with the
+     * result of the operation.
+     */
+    class CompletionTag {
+    public:
+        explicit CompletionTag(std::function<void(bool)> onComplete)
+            : onComplete(std::move(onComplete)) {
+        }
+
+        void complete(bool ok) {
+            onComplete(ok);
+        }
+
+    private:
+        std::function<void(bool)> onComplete;
+    };
+
+    /**
+     * Polls the queue until it is shut down and drained.
+     */
+    inline void pollCompletionQueue(grpc::ServerCompletionQueue *completionQueue) {
+        void *tag;
+        bool ok;
+        while (completionQueue->Next(&tag, &ok)) {
+            static_cast<CompletionTag *>(tag)->complete(ok);
+        }
+    }
+
+    /**
+     * State of one asynchronous call. The call waits for a client request on construction
+     * and deletes itself when both its status is sent and the call is done.
+     */
+    class AsyncCall {
+    public:
+        AsyncCall(const AsyncCall &) = delete;
+        AsyncCall &operator=(const AsyncCall &) = delete;
+
+        virtual ~AsyncCall() = default;
+
+    protected:
+        grpc::ServerContext context;
+        grpc::ServerCompletionQueue *completionQueue;
+        CallExecutor executor;
+        CompletionTag requestTag;
+        CompletionTag finishTag;
+
+        AsyncCall(grpc::ServerCompletionQueue *completionQueue, CallExecutor executor)
+            : completionQueue(completionQueue), executor(std::move(executor)),
+              requestTag([this](bool ok) { onRequest(ok); }),
+              finishTag([this](bool) { release(); }),
+              doneTag([this](bool) {
+                  cancelled = context.IsCancelled();
+                  release();
+              }) {
+            context.AsyncNotifyWhenDone(&doneTag);
+        }
+
+        /**
+         * Called when a client request is matched or the server is shut down.
+         * Implementations start waiting for the next request and execute the handler.
+         */
+        virtual void onRequest(bool ok) = 0;
+
+        virtual void finish(const grpc::Status &status) = 0;
+
+        void execute(std::function<grpc::Status()> handler) {
+            executor([this, handler = std::move(handler)]() {
+                // worker threads are shared by calls, so no state of a previous call may leak
+                RequestEnvironment::ThreadState workerState = RequestEnvironment::getThreadState();
+                RequestEnvironment::setThreadState(
+                    { std::nullopt, &context, &cancelled, workerState.threadName });
+                grpc::Status status;
+                try {
+                    status = handler();
+                } catch (const CancellationException &) {
+                    status = grpc::Status::CANCELLED;
+                } catch (const std::exception &e) {
+                    LOG_S(ERROR) << "Unexpected error in RPC handling: " << e.what();
+                    status = grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+                } catch (...) {
+                    LOG_S(ERROR) << "Unexpected error in RPC handling";
+                    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                                          "Unexpected error in RPC handling");
+                }
+                RequestEnvironment::setThreadState(workerState);
+                finish(status);
+            });
+        }
+
+    private:
+        CompletionTag doneTag;
+        std::atomic_bool cancelled = false;
+        // finish and done tags; done tag is delivered only for matched calls
+        std::atomic_int references = 2;
+
+        void release() {
+            if (--references == 0) {
+                delete this;
+            }
+        }
+    };
+
+    template <typename Request, typename Response>
+    class AsyncUnaryCall : public AsyncCall {
+    public:
+        using Responder = grpc::ServerAsyncResponseWriter<Response>;
+        using RequestMethod = std::function<void(
+            grpc::ServerContext *, Request *, Responder *, grpc::ServerCompletionQueue *, void *)>;
+        using Handler =
+            std::function<grpc::Status(grpc::ServerContext *, const Request *, Response *)>;
+
+        static void listen(RequestMethod requestMethod,
+                           Handler handler,
+                           CallExecutor executor,
+                           grpc::ServerCompletionQueue *completionQueue) {
+            new AsyncUnaryCall(std::move(requestMethod), std::move(handler), std::move(executor),
+                               completionQueue);
+        }
+
+    private:
+        RequestMethod requestMethod;
+        Handler handler;
+        Request request;
+        Response response;
+        Responder responder;
+
+        AsyncUnaryCall(RequestMethod requestMethod,
+                       Handler handler,
+                       CallExecutor executor,
+                       grpc::ServerCompletionQueue *completionQueue)
+            : AsyncCall(completionQueue, std::move(executor)),
+              requestMethod(std::move(requestMethod)), handler(std::move(handler)),
+              responder(&context) {
+            this->requestMethod(&context, &request, &responder, completionQueue, &requestTag);
+        }
+
+        void onRequest(bool ok) override {
+            if (!ok) {
+                // server is shut down
+                delete this;
+                return;
+            }
+            listen(requestMethod, handler, executor, completionQueue);
+            execute([this]() { return handler(&context, &request, &response); });
+        }
+
+        void finish(const grpc::Status &status) override {
+            responder.Finish(response, status, &finishTag);
+        }
+    };
+
+    /**
+     * Server streaming call. Handler writes responses through the blocking
+     * grpc::ServerWriterInterface, so it is the same for synchronous and asynchronous calls.
+     */
+    template <typename Request, typename Response>
+    class AsyncServerStreamingCall : public AsyncCall,
+                                     public grpc::ServerWriterInterface<Response> {
+    public:
+        using Responder = grpc::ServerAsyncWriter<Response>;
+        using RequestMethod = std::function<void(
+            grpc::ServerContext *, Request *, Responder *, grpc::ServerCompletionQueue *, void *)>;
+        using Handler = std::function<grpc::Status(
+            grpc::ServerContext *, const Request *, grpc::ServerWriterInterface<Response> *)>;
+
+        static void listen(RequestMethod requestMethod,
+                           Handler handler,
+                           CallExecutor executor,
+                           grpc::ServerCompletionQueue *completionQueue) {
+            new AsyncServerStreamingCall(std::move(requestMethod), std::move(handler),
+                                         std::move(executor), completionQueue);
+        }
+
+        void SendInitialMetadata() override {
+            std::lock_guard<std::mutex> lock(operationMutex);
+            auto completed = startOperation();
+            responder.SendInitialMetadata(&operationTag);
+            completed.get();
+        }
+
+        bool Write(const Response &message, grpc::WriteOptions options) override {
+            std::lock_guard<std::mutex> lock(operationMutex);
+            auto completed = startOperation();
+            responder.Write(message, options, &operationTag);
+            return completed.get();
+        }
+
+    private:
+        RequestMethod requestMethod;
+        Handler handler;
+        Request request;
+        Responder responder;
+        // only one write may be in flight, so writes are serialized
+        std::mutex operationMutex;
+        std::promise<bool> operationCompleted;
+        CompletionTag operationTag;
+
+        AsyncServerStreamingCall(RequestMethod requestMethod,
+                                 Handler handler,
+                                 CallExecutor executor,
+                                 grpc::ServerCompletionQueue *completionQueue)
+            : AsyncCall(completionQueue, std::move(executor)),
+              requestMethod(std::move(requestMethod)), handler(std::move(handler)),
+              responder(&context),
+              operationTag([this](bool ok) { operationCompleted.set_value(ok); }) {
+            this->requestMethod(&context, &request, &responder, completionQueue, &requestTag);
+        }
+
+        std::future<bool> startOperation() {
+            operationCompleted = std::promise<bool>();
+            return operationCompleted.get_future();
+        }
+
+        void onRequest(bool ok) override {
+            if (!ok) {
+                // server is shut down
+                delete this;
+                return;
+            }
+            listen(requestMethod, handler, executor, completionQueue);
+            execute([this]() { return handler(&context, &request, this); });
+        }
+
+        void finish(const grpc::Status &status) override {
+            responder.Finish(status, &finishTag);
+        }
+    };
+}
+
+#endif // UNITTESTBOT_ASYNCSERVERCALLS_H
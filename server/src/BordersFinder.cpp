@@ -5,18 +5,49 @@
 #include "clang-utils/Matchers.h"
 #include "utils/CollectionUtils.h"
 #include "utils/CompilationUtils.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/HashUtils.h"
+#include "utils/LRUCache.h"
 
 #include "loguru.h"
 
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
 using namespace clang;
 using namespace llvm;
 using namespace clang::ast_matchers;
 
+namespace {
+    using FileSystemUtils::FileStamp;
+
+    struct CachedIndexes {
+        std::size_t commandsHash = 0;
+        std::string contentHash;
+        // stamp of the file when its content was read
+        std::optional<FileStamp> stamp;
+        std::shared_ptr<const BordersFinder::FileIndex> functions;
+        std::shared_ptr<const BordersFinder::FileIndex> classes;
+    };
+
+    // editors request many cursor positions of the same unchanged file
+    const size_t MAX_CACHED_INDEXES = 64;
+
+    std::mutex indexesMutex;
+    LRUCache<fs::path, CachedIndexes> indexes(MAX_CACHED_INDEXES);
+
+    std::shared_ptr<const BordersFinder::FileIndex> getCached(const CachedIndexes &cached,
+                                                              bool forClasses) {
+        return forClasses ? cached.classes : cached.functions;
+    }
+}
+
 BordersFinder::BordersFinder(const fs::path &filePath,
                              unsigned line,
                              const std::shared_ptr<CompilationDatabase> &compilationDatabase,
                              const fs::path &compileCommandsJsonPath)
-        : line(line), classBorder(std::nullopt), clangToolRunner(compilationDatabase) {
+        : line(line), compilationDatabase(compilationDatabase), clangToolRunner(compilationDatabase) {
     buildRootPath = Paths::subtractPath(compileCommandsJsonPath.string(), CompilationUtils::UTBOT_BUILD_DIR_NAME);
     lineInfo.filePath = filePath;
 }
@@ -25,43 +56,89 @@ void BordersFinder::run(const MatchFinder::MatchResult &Result) {
     LOG_SCOPE_FUNCTION(MAX);
     if (const auto *ST = Result.Nodes.getNodeAs<clang::CXXRecordDecl>(Matchers::STRUCT_OR_CLASS_JUST_DECL)) {
         SourceManager &sourceManager = Result.Context->getSourceManager();
-        fs::path path = sourceManager.getFileEntryForID(sourceManager.getMainFileID())
-                ->tryGetRealPathName()
-                .str();
         auto borders = getBorders(sourceManager, ST->getSourceRange());
-        if (!containsLine(borders) || (classBorder.has_value() && !(borders < classBorder.value()))) {
-            return;
-        }
-        classBorder = borders;
-        lineInfo.begin = borders.start.line;
-        lineInfo.end = borders.end.line;
-        lineInfo.scopeName = ST->getNameAsString();
-        lineInfo.initialized = true;
+        index->classes.push_back({ borders, ST->getNameAsString() });
         LOG_S(MAX) << "Class name: " << ST->getNameAsString();
-        LOG_S(MAX) << "Class's borders: " << lineInfo.begin << ' ' << lineInfo.end;
+        LOG_S(MAX) << "Class's borders: " << borders.start.line << ' ' << borders.end.line;
     } else if (const auto *FS = Result.Nodes.getNodeAs<FunctionDecl>(Matchers::FUNCTION_DEF)) {
         SourceManager &sourceManager = Result.Context->getSourceManager();
 
         fs::path path = sourceManager.getFileEntryForID(sourceManager.getMainFileID())
                 ->tryGetRealPathName()
                 .str();
-        Stmt *currentStmt = FS->getBody();
-        if ((currentStmt == nullptr) || !containsLine(getFunctionBordersLines(sourceManager, FS))) {
+        Stmt *body = FS->getBody();
+        if (body == nullptr) {
             return;
         }
+        FileIndex::FunctionEntry function;
+        function.body = indexStmt(*Result.Context, body);
+        function.scopeName = getScopeName(FS, path);
+        function.methodName = FS->getNameAsString();
+        const clang::QualType realReturnType = FS->getReturnType().getCanonicalType();
+        function.returnType = ParamsHandler::getType(realReturnType, realReturnType, sourceManager);
+        LOG_S(MAX) << "Method name: " << function.methodName << "\n"
+                   << "Method's borders: " << function.body.borders.start.line << ' '
+                   << function.body.borders.end.line;
+        index->functions.push_back(std::move(function));
+    }
+}
+
+BordersFinder::FileIndex::StmtEntry BordersFinder::indexStmt(ASTContext &context, const Stmt *st) {
+    const SourceManager &sourceManager = context.getSourceManager();
+    FileIndex::StmtEntry entry;
+    entry.borders = getStmtBordersLines(sourceManager, st);
+    entry.isBranchOrLoop = isa<IfStmt>(st) || isa<ForStmt>(st) || isa<WhileStmt>(st);
+    entry.isReturn = isa<ReturnStmt>(st);
+
+    SourceRange textRange = st->getSourceRange();
+    auto parents = context.getParents(*st);
+    const int MAX_ITERATIONS = 50;
+    // if more than MAX_ITERATIONS happen, something is wrong
+    for (int it = 0; it < MAX_ITERATIONS; ++it) {
+        if (parents.empty()) {
+            break;
+        }
+        auto tempBorders = getStmtBordersLinesDynamic(sourceManager, parents[0]);
+        int from = tempBorders.start.line;
+        int to = tempBorders.end.line;
+        if (to - from > 1) {
+            break;
+        }
+        textRange = parents[0].getSourceRange();
+        parents = context.getParents(parents[0]);
+    }
+    auto textKey = std::make_pair(textRange.getBegin().getRawEncoding(),
+                                  textRange.getEnd().getRawEncoding());
+    auto it = textIndexes.find(textKey);
+    if (it == textIndexes.end()) {
+        it = textIndexes.emplace(textKey, index->texts.size()).first;
+        index->texts.push_back(ASTPrinter::getSourceText(textRange, sourceManager));
+    }
+    entry.textIndex = it->second;
+
+    for (const Stmt *child : st->children()) {
+        if (child != nullptr) {
+            entry.children.push_back(indexStmt(context, child));
+        }
+    }
+    return entry;
+}
+
+void BordersFinder::resolveFunction(const FileIndex &fileIndex) {
+    for (const auto &function : fileIndex.functions) {
+        if (!containsLine(function.body.borders)) {
+            continue;
+        }
+        const FileIndex::StmtEntry *currentStmt = &function.body;
         bool hasInnerChild = true;
         while (hasInnerChild) {
             hasInnerChild = false;
-            for (auto child : currentStmt->children()) {
-                if (child == nullptr) {
-                    continue;
-                }
-                auto borders = getStmtBordersLines(sourceManager, child);
+            for (const auto &child : currentStmt->children) {
+                const auto &borders = child.borders;
                 if (containsLine(borders)) {
-                    currentStmt = child;
+                    currentStmt = &child;
                     hasInnerChild = true;
-                    if (isa<IfStmt>(currentStmt) || isa<ForStmt>(currentStmt) ||
-                        isa<WhileStmt>(currentStmt)) {
+                    if (child.isBranchOrLoop) {
                         if (line == borders.start.line) {
                             hasInnerChild = false;
                         } else {
@@ -69,47 +146,36 @@ void BordersFinder::run(const MatchFinder::MatchResult &Result) {
                             lineInfo.insertAfter = false;
                         }
                     }
-                    if (line == borders.start.line && isa<ReturnStmt>(currentStmt)) {
+                    if (line == borders.start.line && child.isReturn) {
                         lineInfo.insertAfter = false;
                     }
                     break;
                 }
             }
         }
-        auto borders = getStmtBordersLines(sourceManager, currentStmt);
-        lineInfo.begin = borders.start.line;
-        lineInfo.end = borders.end.line;
-        if (auto namedParent = dyn_cast<NamedDecl>(FS->getParent())) {
-            lineInfo.scopeName = namedParent->getNameAsString();
-        } else {
-            lineInfo.scopeName = path.stem().string();
-        }
-        lineInfo.methodName = FS->getNameAsString();
-        const clang::QualType realReturnType = FS->getReturnType().getCanonicalType();
-        lineInfo.functionReturnType = ParamsHandler::getType(realReturnType, realReturnType, sourceManager);
+        lineInfo.begin = currentStmt->borders.start.line;
+        lineInfo.end = currentStmt->borders.end.line;
+        lineInfo.scopeName = function.scopeName;
+        lineInfo.methodName = function.methodName;
+        lineInfo.functionReturnType = function.returnType;
         lineInfo.initialized = true;
+        lineInfo.stmtString = fileIndex.texts[currentStmt->textIndex];
+        LOG_S(DEBUG) << "Statement string: " << lineInfo.stmtString;
+    }
+}
 
-        std::string strRepresentation = ASTPrinter::getSourceText(currentStmt->getSourceRange(), sourceManager);
-        auto parents = Result.Context->getParents(*currentStmt);
-        const int MAX_ITERATIONS = 50;
-        // if more than MAX_ITERATIONS happen, something is wrong
-        for (int it = 0; it < MAX_ITERATIONS; ++it) {
-            if (parents.empty()) {
-                break;
-            }
-            auto tempBorders = getStmtBordersLinesDynamic(sourceManager, parents[0]);
-            int from = tempBorders.start.line;
-            int to = tempBorders.end.line;
-            if (to - from > 1) {
-                break;
-            }
-            strRepresentation = ASTPrinter::getSourceText(parents[0].getSourceRange(), sourceManager);
-            parents = Result.Context->getParents(parents[0]);
+void BordersFinder::resolveClass(const FileIndex &fileIndex) {
+    std::optional<Borders> classBorder;
+    for (const auto &classEntry : fileIndex.classes) {
+        const auto &borders = classEntry.borders;
+        if (!containsLine(borders) || (classBorder.has_value() && !(borders < classBorder.value()))) {
+            continue;
         }
-        lineInfo.stmtString = strRepresentation;
-        LOG_S(MAX) << "Method name: " << lineInfo.methodName << "\n"
-                   << "Method's borders: " << borders.start.line << ' ' << borders.end.line;
-        LOG_S(DEBUG) << "Statement string: " << lineInfo.stmtString;
+        classBorder = borders;
+        lineInfo.begin = borders.start.line;
+        lineInfo.end = borders.end.line;
+        lineInfo.scopeName = classEntry.name;
+        lineInfo.initialized = true;
     }
 }
 
@@ -117,9 +183,12 @@ LineInfo BordersFinder::getLineInfo() {
     return lineInfo;
 }
 
-BordersFinder::Borders BordersFinder::getFunctionBordersLines(const SourceManager &srcMng, const FunctionDecl *FS) {
-    auto currentStmt = FS->getBody();
-    return getStmtBordersLines(srcMng, currentStmt);
+std::string BordersFinder::getScopeName(const clang::FunctionDecl *functionDecl,
+                                        const fs::path &sourceFilePath) {
+    if (auto namedParent = llvm::dyn_cast<clang::NamedDecl>(functionDecl->getParent())) {
+        return namedParent->getNameAsString();
+    }
+    return sourceFilePath.stem().string();
 }
 
 BordersFinder::Borders BordersFinder::getStmtBordersLines(const SourceManager &srcMng, const Stmt *st) {
@@ -146,16 +215,100 @@ bool BordersFinder::containsLine(BordersFinder::Borders b) const {
 }
 
 void BordersFinder::findFunction() {
-    MatchFinder finder;
-    finder.addMatcher(Matchers::functionDefinitionMatcher, this);
-    auto factory = clang::tooling::newFrontendActionFactory(&finder);
-    clangToolRunner.run(lineInfo.filePath, factory.get());
+    resolveFunction(*getIndex(false));
 }
 
 void BordersFinder::findClass() {
+    resolveClass(*getIndex(true));
+}
+
+std::size_t BordersFinder::getCommandsHash() const {
+    std::size_t commandsHash = 0;
+    auto commands = compilationDatabase->getClangCompilationDatabase().getCompileCommands(
+        lineInfo.filePath.string());
+    for (const auto &command : commands) {
+        for (const auto &argument : command.CommandLine) {
+            HashUtils::hashCombine(commandsHash, argument);
+        }
+    }
+    return commandsHash;
+}
+
+bool BordersFinder::isIndexReused() const {
+    return indexReused;
+}
+
+std::shared_ptr<const BordersFinder::FileIndex> BordersFinder::getIndex(bool forClasses) {
+    indexReused = false;
+    std::size_t commandsHash = getCommandsHash();
+    // taken before reading, so a change during reading makes the next lookup read the file again
+    std::optional<FileStamp> stamp = FileSystemUtils::getFileStamp(lineInfo.filePath);
+    if (stamp.has_value()) {
+        std::lock_guard<std::mutex> lock(indexesMutex);
+        CachedIndexes *cachedIndexes = indexes.get(lineInfo.filePath);
+        if (cachedIndexes != nullptr && cachedIndexes->commandsHash == commandsHash &&
+            cachedIndexes->stamp == stamp) {
+            if (auto cached = getCached(*cachedIndexes, forClasses)) {
+                LOG_S(DEBUG) << "File is not modified, reusing its borders index: "
+                             << lineInfo.filePath;
+                indexReused = true;
+                return cached;
+            }
+        }
+    }
+    std::ifstream stream(lineInfo.filePath, std::ios::binary);
+    if (!stream) {
+        // Clang reports the missing file
+        return buildIndex(forClasses, std::nullopt);
+    }
+    std::string content{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+    std::string contentHash = HashUtils::contentHash(content);
+    {
+        std::lock_guard<std::mutex> lock(indexesMutex);
+        CachedIndexes *cachedIndexes = indexes.get(lineInfo.filePath);
+        if (cachedIndexes != nullptr && cachedIndexes->commandsHash == commandsHash &&
+            cachedIndexes->contentHash == contentHash) {
+            // file was only touched
+            cachedIndexes->stamp = stamp;
+            if (auto cached = getCached(*cachedIndexes, forClasses)) {
+                LOG_S(DEBUG) << "File is not changed, reusing its borders index: "
+                             << lineInfo.filePath;
+                indexReused = true;
+                return cached;
+            }
+        }
+    }
+    // index is built from the same content that is hashed, so it can't be newer than the key
+    std::shared_ptr<const FileIndex> fileIndex = buildIndex(forClasses, content);
+    std::lock_guard<std::mutex> lock(indexesMutex);
+    CachedIndexes *cached = indexes.get(lineInfo.filePath);
+    if (cached == nullptr || cached->commandsHash != commandsHash ||
+        cached->contentHash != contentHash) {
+        cached = &indexes.put(lineInfo.filePath,
+                              { commandsHash, contentHash, stamp, nullptr, nullptr });
+    }
+    cached->stamp = stamp;
+    (forClasses ? cached->classes : cached->functions) = fileIndex;
+    return fileIndex;
+}
+
+std::shared_ptr<BordersFinder::FileIndex>
+BordersFinder::buildIndex(bool forClasses, const std::optional<std::string> &content) {
+    index = std::make_shared<FileIndex>();
+    textIndexes.clear();
     MatchFinder finder;
-    finder.addMatcher(Matchers::classJustDeclMatcher, this);
-    finder.addMatcher(Matchers::structJustDeclMatcher, this);
+    if (forClasses) {
+        finder.addMatcher(Matchers::classJustDeclMatcher, this);
+        finder.addMatcher(Matchers::structJustDeclMatcher, this);
+    } else {
+        finder.addMatcher(Matchers::functionDefinitionMatcher, this);
+    }
     auto factory = clang::tooling::newFrontendActionFactory(&finder);
-    clangToolRunner.run(lineInfo.filePath, factory.get(), false, std::nullopt, false);
+    if (forClasses) {
+        clangToolRunner.run(lineInfo.filePath, factory.get(), false, content, false);
+    } else {
+        clangToolRunner.run(lineInfo.filePath, factory.get(), false, content);
+    }
+    textIndexes.clear();
+    return std::move(index);
 }
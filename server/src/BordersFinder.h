@@ -10,8 +10,12 @@
 #include <clang/Tooling/Tooling.h>
 
 #include "utils/path/FileSystemPath.h"
+#include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 class BordersFinder : public clang::ast_matchers::MatchFinder::MatchCallback {
 public:
@@ -28,10 +32,17 @@ public:
 
     LineInfo getLineInfo();
 
-private:
-    unsigned line;
-    LineInfo lineInfo{};
-    fs::path buildRootPath;
+    /**
+     * @return name of the class or namespace of the function, or the stem of its source file.
+     */
+    static std::string getScopeName(const clang::FunctionDecl *functionDecl,
+                                    const fs::path &sourceFilePath);
+
+    /**
+     * @return true if the last lookup used the index of the file built by a previous lookup.
+     */
+    [[nodiscard]] bool isIndexReused() const;
+
     struct Borders {
         struct Position {
             unsigned line;
@@ -47,11 +58,67 @@ private:
                    (rhs.end.line == lhs.start.line && rhs.end.column >= lhs.start.column));
         }
     };
-    std::optional<Borders> classBorder;
+
+    /**
+     * Ranges of functions with their statements and ranges of classes of one file. Index is
+     * built from the AST once and then resolves any line of the unchanged file without Clang.
+     */
+    struct FileIndex {
+        struct StmtEntry {
+            Borders borders;
+            bool isBranchOrLoop = false;
+            bool isReturn = false;
+            // index in texts of the statement string printed for this statement
+            size_t textIndex = 0;
+            std::vector<StmtEntry> children;
+        };
+
+        struct FunctionEntry {
+            StmtEntry body;
+            std::string methodName;
+            std::string scopeName;
+            types::Type returnType;
+        };
+
+        struct ClassEntry {
+            Borders borders;
+            std::string name;
+        };
+
+        std::vector<FunctionEntry> functions;
+        std::vector<ClassEntry> classes;
+        // statements of one line share the text of their common parent, so texts are stored once
+        std::vector<std::string> texts;
+    };
+
+private:
+    unsigned line;
+    LineInfo lineInfo{};
+    fs::path buildRootPath;
+    std::shared_ptr<CompilationDatabase> compilationDatabase;
     ClangToolRunner clangToolRunner;
+    // index which is being built by run
+    std::shared_ptr<FileIndex> index;
+    bool indexReused = false;
+    // positions of the ranges of already printed statement strings to their indexes in texts
+    std::map<std::pair<unsigned, unsigned>, size_t> textIndexes;
 
     // TODO: use rewriter for insertion
 
+    /**
+     * Indexes of recently used files are kept between lookups. The file is not read again
+     * while its size and modification time are the same, and the index is not rebuilt while
+     * its content is the same.
+     */
+    std::shared_ptr<const FileIndex> getIndex(bool forClasses);
+
+    std::shared_ptr<FileIndex> buildIndex(bool forClasses,
+                                          const std::optional<std::string> &content);
+
+    [[nodiscard]] std::size_t getCommandsHash() const;
+
+    FileIndex::StmtEntry indexStmt(clang::ASTContext &context, const clang::Stmt *st);
+
     Borders getStmtBordersLines(const clang::SourceManager &srcMng, const clang::Stmt *st);
 
     Borders getStmtBordersLinesDynamic(const clang::SourceManager &srcMng, clang::ast_type_traits::DynTypedNode st);
@@ -60,7 +127,9 @@ private:
 
     static Borders getBorders(const clang::SourceManager &srcMng, const clang::SourceRange &sourceRange);
 
-    Borders getFunctionBordersLines(const clang::SourceManager &srcMng, const clang::FunctionDecl *FS);
+    void resolveFunction(const FileIndex &fileIndex);
+
+    void resolveClass(const FileIndex &fileIndex);
 };
 
 
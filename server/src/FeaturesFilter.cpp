@@ -28,6 +28,18 @@ void FeaturesFilter::filter(utbot::SettingsContext const &settingsContext,
         filterGlobalParameters(typesHandler, tests);
 
 
+        using SkipReason = tests::Tests::SkipRecord::Reason;
+        size_t skippedForTypes = 0;
+        auto skip = [&](const tests::Tests::MethodDescription &method, SkipReason reason,
+                        std::string subject = "", std::string info = "") {
+            if (reason == SkipReason::UNSUPPORTED_RETURN_TYPE ||
+                reason == SkipReason::UNSUPPORTED_PARAMETER) {
+                skippedForTypes++;
+            }
+            tests.skipRecords.push_back(
+                { reason, method.name, std::move(subject), std::move(info) });
+            return true;
+        };
         size_t erased = CollectionUtils::erase_if(tests.methods,
                      [&](const tests::Tests::MethodDescription &method) {
                          auto returnTypeSupport = typesHandler.isSupportedType(method.returnType, types::TypeUsage::RETURN);
@@ -35,13 +47,8 @@ void FeaturesFilter::filter(utbot::SettingsContext const &settingsContext,
                                                  "Method has incomplete return type");
                          if (!returnTypeSupport.isSupported) {
                              unsupportedStatistics[returnTypeSupport.info]++;
-                             std::stringstream message;
-                             message << "Function '" << method.name << "' was skipped, as return type '"
-                                     << method.returnType.typeName()
-                                     << "' is not fully supported: " << returnTypeSupport.info;
-                             LOG_S(WARNING) << message.str();
-                             tests.commentBlocks.push_back(message.str());
-                             return true;
+                             return skip(method, SkipReason::UNSUPPORTED_RETURN_TYPE,
+                                         method.returnType.typeName(), returnTypeSupport.info);
                          }
 
                          for (const auto &param: method.params) {
@@ -50,40 +57,28 @@ void FeaturesFilter::filter(utbot::SettingsContext const &settingsContext,
                                                      "Parameter has incomplete type");
                              if (!paramTypeSupport.isSupported) {
                                  unsupportedStatistics[paramTypeSupport.info]++;
-                                 std::stringstream message;
-                                 message << "Function '" << method.name << "' was skipped, as parameter '" << param.name
-                                         << "' is not fully supported: " << paramTypeSupport.info;
-                                 LOG_S(WARNING) << message.str();
-                                 tests.commentBlocks.push_back(message.str());
-                                 return true;
+                                 return skip(method, SkipReason::UNSUPPORTED_PARAMETER, param.name,
+                                             paramTypeSupport.info);
                              }
                          }
 
                          if (method.modifiers.isStatic && !settingsContext.generateForStaticFunctions) {
-                             std::stringstream message;
-                             message << "Function '" << method.name
-                                     << "' was skipped, as option \"Generate For Static Functions\""
-                                     << "is disabled";
-                             LOG_S(DEBUG) << message.str();
-                             tests.commentBlocks.push_back(message.str());
-                             return true;
+                             return skip(method, SkipReason::STATIC_FUNCTION);
                          }
 
                          if (method.modifiers.isInline &&
                              (!method.modifiers.isStatic && !method.modifiers.isExtern)) {
-                             std::stringstream message;
-                             message
-                                 << "Function '" << method.name
-                                 << "' was skipped, as inline function without static or extern "
-                                    "modifier is not supported by now";
-                             LOG_S(DEBUG) << message.str();
-                             tests.commentBlocks.push_back(message.str());
-                             return true;
+                             return skip(method, SkipReason::INLINE_FUNCTION);
                          }
                          unsupportedStatistics["passed features filter"]++;
 
                          return false;
                      });
+        if (skippedForTypes > 0) {
+            LOG_S(WARNING) << skippedForTypes << " functions in file " << sourceFile
+                           << " were skipped, as their types are not fully supported. "
+                              "See comments in generated tests for details.";
+        }
         LOG_S(DEBUG) << erased << " erased methods for file " << sourceFile;
         if (!tests.methods.empty()) {
             hasSupportedMethods = true;
@@ -354,6 +354,8 @@ void KleeGenerator::parseKTestsToFinalCode(
     printer::HeaderPrinter(Paths::getSourceLanguage(tests.sourceFilePath)).print(tests.testHeaderFilePath, tests.sourceFilePath,
                                    tests.headerCode);
     testsPrinter.joinToFinalCode(tests, tests.testHeaderFilePath);
+    printer::TestsPrinter::printTestManifest(
+        tests, Paths::getTestManifestPath(projectContext, tests.sourceFilePath));
     LOG_S(DEBUG) << "Generated code for " << tests.methods.size() << " tests";
 }
 
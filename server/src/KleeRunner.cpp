@@ -69,7 +69,9 @@ void KleeRunner::runKlee(const std::vector<tests::TestMethod> &testMethods,
         fileToMethods[method.sourceFilePath].push_back(method);
     }
 
-    nlohmann::json sarifResults = nlohmann::json::array();
+    fs::path sarifReportPath = projectContext.projectPath / sarif::SARIF_DIR_NAME / sarif::SARIF_FILE_NAME;
+    // the report is streamed next to its final location and replaces the previous one at the end
+    sarif::SarifStreamWriter sarifWriter(sarifReportPath.string() + ".part");
 
     std::function<void(tests::Tests &tests)> prepareTests = [&](tests::Tests &tests) {
         fs::path filePath = tests.sourceFilePath;
@@ -110,13 +112,13 @@ void KleeRunner::runKlee(const std::vector<tests::TestMethod> &testMethods,
                                           settingsContext.verbose);
         generationStats.addFileStats(kleeStats, tests);
 
-        sarif::sarifAddTestsToResults(projectContext, tests, sarifResults);
+        sarifWriter.addTestsToResults(projectContext, tests);
     };
 
     std::function<void()> prepareTotal = [&]() {
-        testsWriter->writeReport(sarif::sarifPackResults(sarifResults),
+        testsWriter->writeReport(sarifWriter,
                                  "Sarif Report was created",
-                                 projectContext.projectPath / sarif::SARIF_DIR_NAME / sarif::SARIF_FILE_NAME);
+                                 sarifReportPath);
     };
 
     testsWriter->writeTestsWithProgress(
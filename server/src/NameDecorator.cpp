@@ -3,16 +3,78 @@
 #include "utils/CollectionUtils.h"
 #include "utils/StringUtils.h"
 
-#include <iterator>
+#include <cstdint>
+
+namespace {
+    // same set of characters as \w in std::regex with the classic locale
+    bool isWordCharacter(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+}
 
 std::string NameDecorator::decorate(std::string_view name) {
+    const KeywordsTable &keywords = getCppOnlyKeywordsTable();
     std::string result;
-    std::regex_replace(std::back_inserter(result), name.begin(), name.end(),
-                       CPP_ONLY_KEYWORDS_REGEX, "$&_");
-    // add underscore at the end of name
+    result.reserve(name.size() + 1);
+    size_t i = 0;
+    while (i < name.size()) {
+        if (!isWordCharacter(name[i])) {
+            result.push_back(name[i++]);
+            continue;
+        }
+        size_t wordStart = i;
+        while (i < name.size() && isWordCharacter(name[i])) {
+            ++i;
+        }
+        std::string_view word = name.substr(wordStart, i - wordStart);
+        result.append(word);
+        if (keywords.contains(word)) {
+            // add underscore at the end of name
+            result.push_back('_');
+        }
+    }
     return result;
 }
 
+NameDecorator::KeywordsTable::KeywordsTable(const std::unordered_set<std::string> &keywords) {
+    // keywords are few and the table is sparse, so a collision-free seed is found quickly
+    while (!tryFill(keywords)) {
+        ++seed;
+    }
+}
+
+bool NameDecorator::KeywordsTable::tryFill(const std::unordered_set<std::string> &keywords) {
+    slots.assign(TABLE_SIZE, "");
+    for (const std::string &keyword : keywords) {
+        std::string &cell = slots[slot(keyword)];
+        if (!cell.empty()) {
+            return false;
+        }
+        cell = keyword;
+    }
+    return true;
+}
+
+size_t NameDecorator::KeywordsTable::slot(std::string_view word) const {
+    // FNV-1a
+    uint32_t hash = 2166136261u ^ seed;
+    for (char c : word) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash % TABLE_SIZE;
+}
+
+bool NameDecorator::KeywordsTable::contains(std::string_view word) const {
+    const std::string &cell = slots[slot(word)];
+    return !cell.empty() && cell == word;
+}
+
+const NameDecorator::KeywordsTable &NameDecorator::getCppOnlyKeywordsTable() {
+    static const KeywordsTable table(CPP_ONLY_KEYWORDS);
+    return table;
+}
+
 std::string NameDecorator::defineWcharT(std::string_view canonicalName) {
     return StringUtils::stringFormat("#define wchar_t %.*s", canonicalName.length(),
                                      canonicalName.data());
@@ -136,11 +198,6 @@ const std::unordered_set<std::string> NameDecorator::CPP_KEYWORDS = {
 const std::unordered_set<std::string> NameDecorator::CPP_ONLY_KEYWORDS = CollectionUtils::filterOut(
         CPP_KEYWORDS, [](std::string const &s) { return CollectionUtils::contains(C_KEYWORDS, s); });
 
-const std::regex NameDecorator::CPP_ONLY_KEYWORDS_REGEX{
-    "\\b(" + StringUtils::joinWith(CPP_ONLY_KEYWORDS, "|") + ")\\b"
-};
-
-
 const std::unordered_set<std::string> NameDecorator::CPP_OPERATORS = {
     "xor", "xor_eq", "or", "not", "or_eq", "not_eq", "compl", "bitor", "bitand", "and_eq", "and"
 };
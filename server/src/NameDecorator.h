@@ -1,8 +1,9 @@
 #ifndef UNITTESTBOT_NAMEDECORATOR_H
 #define UNITTESTBOT_NAMEDECORATOR_H
 
-#include <regex>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -20,8 +21,6 @@ public:
 
     static const std::unordered_set<std::string> CPP_ONLY_KEYWORDS;
 
-    static const std::regex CPP_ONLY_KEYWORDS_REGEX;
-
     static const std::unordered_set<std::string> CPP_OPERATORS;
 
     static const std::vector<std::string> DEFINES;
@@ -34,6 +33,29 @@ public:
 
 private:
     static const std::unordered_set<std::string> TO_DEFINE;
+
+    /**
+     * Perfect hash table of CPP_ONLY_KEYWORDS: every keyword gets its own slot, so lookup of a
+     * word costs one hash computation and at most one comparison.
+     */
+    class KeywordsTable {
+    public:
+        explicit KeywordsTable(const std::unordered_set<std::string> &keywords);
+
+        [[nodiscard]] bool contains(std::string_view word) const;
+
+    private:
+        static constexpr size_t TABLE_SIZE = 1024;
+
+        uint32_t seed = 0;
+        std::vector<std::string> slots;
+
+        [[nodiscard]] size_t slot(std::string_view word) const;
+
+        bool tryFill(const std::unordered_set<std::string> &keywords);
+    };
+
+    static const KeywordsTable &getCppOnlyKeywordsTable();
 };
 
 
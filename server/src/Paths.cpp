@@ -24,11 +24,15 @@ namespace Paths {
     filterPathsByDirNames(const CollectionUtils::FileSet &paths,
                           const std::vector<fs::path> &dirPaths,
                           const std::function<bool(const fs::path &path)> &filter) {
+        // set lookup compares paths exactly, so both sides are normalized
+        CollectionUtils::FileSet dirs;
+        for (const auto &dirPath : dirPaths) {
+            dirs.insert(dirPath.lexically_normal());
+        }
         CollectionUtils::FileSet filtered =
-            CollectionUtils::filterOut(paths, [&dirPaths, &filter](const fs::path &path) {
-                return !std::any_of(dirPaths.begin(), dirPaths.end(), [&](const fs::path &dirPath) {
-                    return path.parent_path() == dirPath && fs::exists(path) && filter(path);
-                });
+            CollectionUtils::filterOut(paths, [&dirs, &filter](const fs::path &path) {
+                return !CollectionUtils::contains(dirs, path.lexically_normal().parent_path()) ||
+                       !fs::exists(path) || !filter(path);
             });
         return filtered;
     }
@@ -231,6 +235,9 @@ namespace Paths {
     fs::path getTestObjectDir(const utbot::ProjectContext &projectContext) {
         return getUtbotBuildDir(projectContext) / "test_objects";
     }
+    fs::path getPlainBuildDir(const utbot::ProjectContext &projectContext) {
+        return getUtbotBuildDir(projectContext) / "plain";
+    }
     fs::path getCoverageDir(const utbot::ProjectContext &projectContext) {
         return getUtbotBuildDir(projectContext) / "coverage";
     }
@@ -248,6 +255,11 @@ namespace Paths {
         auto headerDir = getGeneratedHeaderDir(projectContext, sourceFilePath);
         return headerDir / replaceExtension(Paths::sourcePathToTestName(sourceFilePath), ".h");
     }
+    fs::path getTestManifestPath(const utbot::ProjectContext &projectContext, const fs::path &sourceFilePath) {
+        fs::path manifestDir = getUtbotBuildDir(projectContext) / "test_manifests" /
+                               getRelativeDirPath(projectContext, sourceFilePath);
+        return manifestDir / replaceExtension(Paths::sourcePathToTestName(sourceFilePath), ".json");
+    }
     fs::path getRecompiledFile(const utbot::ProjectContext &projectContext,
                                const fs::path &filePath) {
         fs::path newFilename;
@@ -269,8 +281,8 @@ namespace Paths {
         return getClangCoverageDir(projectContext) / "coverage.json";
     }
 
-    fs::path getGcdaDirPath(const utbot::ProjectContext &projectContext) {
-        return getRecompiledDir(projectContext);
+    std::vector<fs::path> getGcdaDirPaths(const utbot::ProjectContext &projectContext) {
+        return { getRecompiledDir(projectContext), getPlainBuildDir(projectContext) };
     }
 
     fs::path getBuildFilePath(const utbot::ProjectContext &projectContext,
@@ -329,6 +329,12 @@ namespace Paths {
 
     fs::path getTestObjectDir(const utbot::ProjectContext &projectContext);
 
+    /**
+     * Directory of objects and test executables built without sanitizers. Sanitized builds
+     * use getRecompiledDir and getTestObjectDir, so switching modes doesn't rebuild anything.
+     */
+    fs::path getPlainBuildDir(const utbot::ProjectContext &projectContext);
+
     fs::path getCoverageDir(const utbot::ProjectContext &projectContext);
 
     fs::path getClangCoverageDir(const utbot::ProjectContext &projectContext);
@@ -339,6 +345,11 @@ namespace Paths {
 
     fs::path getGeneratedHeaderPath(const utbot::ProjectContext &projectContext, const fs::path &sourceFilePath);
 
+    /**
+     * Path of the list of tests which the server printed to the test file of the source file.
+     */
+    fs::path getTestManifestPath(const utbot::ProjectContext &projectContext, const fs::path &sourceFilePath);
+
     fs::path getRecompiledFile(const utbot::ProjectContext &projectContext, const fs::path &filePath);
 
     fs::path getProfrawFilePath(const utbot::ProjectContext &projectContext, const std::string &testName);
@@ -347,7 +358,7 @@ namespace Paths {
 
     fs::path getCoverageJsonPath(const utbot::ProjectContext &projectContext);
 
-    fs::path getGcdaDirPath(const utbot::ProjectContext &projectContext);
+    std::vector<fs::path> getGcdaDirPaths(const utbot::ProjectContext &projectContext);
 
     fs::path getGcdaFilePath(const utbot::ProjectContext &projectContext, const fs::path &sourceFilePath);
 
@@ -1,8 +1,13 @@
 #include "RequestEnvironment.h"
 
+#include "loguru.h"
+
+#include <vector>
+
 namespace RequestEnvironment {
     thread_local std::optional<std::string> clientId;
     thread_local grpc::ServerContext *serverContext;
+    thread_local const std::atomic_bool *cancellationFlag = nullptr;
 
     const std::string &getClientId() {
         if (!clientId.has_value()) {
@@ -24,7 +29,27 @@ namespace RequestEnvironment {
         serverContext = requestServerContext;
     }
 
+    void setCancellationFlag(const std::atomic_bool *requestCancellationFlag) {
+        cancellationFlag = requestCancellationFlag;
+    }
+
     bool isCancelled() {
+        if (cancellationFlag != nullptr) {
+            return cancellationFlag->load();
+        }
         return serverContext && serverContext->IsCancelled();
     }
+
+    ThreadState getThreadState() {
+        std::vector<char> threadName(LOGURU_BUFFER_SIZE);
+        loguru::get_thread_name(threadName.data(), LOGURU_BUFFER_SIZE, false);
+        return { clientId, serverContext, cancellationFlag, threadName.data() };
+    }
+
+    void setThreadState(const ThreadState &state) {
+        clientId = state.clientId;
+        serverContext = state.serverContext;
+        cancellationFlag = state.cancellationFlag;
+        loguru::set_thread_name(state.threadName.c_str());
+    }
 }
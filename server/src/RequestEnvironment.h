@@ -3,15 +3,39 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <atomic>
+#include <optional>
+#include <string>
+
 namespace RequestEnvironment {
     extern thread_local std::optional<std::string> clientId;
     extern thread_local grpc::ServerContext *serverContext;
+    extern thread_local const std::atomic_bool *cancellationFlag;
 
     const std::string &getClientId();
     const grpc::ServerContext *getServerContext();
     void setClientId(std::string requestClientId);
     void setServerContext(grpc::ServerContext *requestServerContext);
+    /**
+     * Asynchronous calls may not query their context for cancellation, so they provide
+     * the flag that is set once the call is done.
+     */
+    void setCancellationFlag(const std::atomic_bool *requestCancellationFlag);
     bool isCancelled();
+
+    /**
+     * Request state of a thread. Worker threads take it over from the thread of the request,
+     * so their logs reach the client and they see cancellation of the request.
+     */
+    struct ThreadState {
+        std::optional<std::string> clientId;
+        grpc::ServerContext *serverContext = nullptr;
+        const std::atomic_bool *cancellationFlag = nullptr;
+        std::string threadName;
+    };
+
+    ThreadState getThreadState();
+    void setThreadState(const ThreadState &state);
 };
 
 
@@ -5,6 +5,9 @@
 
 void ReturnTypesFetcher::fetch(ProgressWriter *const progressWriter,
                                const CollectionUtils::FileSet &allFiles) {
+    if (allFiles.empty()) {
+        return;
+    }
     tests::TestsMap testsMap;
     for (const auto &filePath : allFiles) {
         testsMap[filePath];
@@ -1,10 +1,14 @@
 #include "SARIFGenerator.h"
 #include "Paths.h"
+#include "exceptions/FileSystemException.h"
 
 #include "loguru.h"
 
-#include <fstream>
-#include <regex>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <filesystem>
+#include <system_error>
 #include <unordered_map>
 
 using namespace tests;
@@ -44,9 +48,142 @@ namespace sarif {
         return relToProject;
     }
 
-    void sarifAddTestsToResults(const utbot::ProjectContext &projectContext,
-                                const Tests &tests,
-                                json &results) {
+    std::optional<StackFrame> parseStackFrame(std::string_view line) {
+        // \s+#
+        size_t hashPos = 0;
+        while (hashPos < line.size() && std::isspace(static_cast<unsigned char>(line[hashPos]))) {
+            ++hashPos;
+        }
+        if (hashPos == 0 || hashPos == line.size() || line[hashPos] != '#') {
+            return std::nullopt;
+        }
+        // :(\d+) at the end of line
+        size_t colonPos = line.rfind(':');
+        if (colonPos == std::string_view::npos || colonPos + 1 == line.size()) {
+            return std::nullopt;
+        }
+        std::string_view lineNumber = line.substr(colonPos + 1);
+        for (char c : lineNumber) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) {
+                return std::nullopt;
+            }
+        }
+        StackFrame frame{};
+        auto [ptr, ec] = std::from_chars(lineNumber.data(), lineNumber.data() + lineNumber.size(),
+                                         frame.line);
+        if (ec != std::errc()) {
+            return std::nullopt;
+        }
+
+        // (.*) is greedy, so the rightmost suitable " in " gives the same groups as the regex
+        const std::string_view IN = " in ";
+        const std::string_view AT = " at ";
+        for (size_t inPos = line.rfind(IN); inPos != std::string_view::npos && inPos > hashPos;
+             inPos = line.rfind(IN, inPos - 1)) {
+            // ([^ ]*) [(][^)]*[)] at ([^:]*)
+            size_t functionStart = inPos + IN.size();
+            size_t functionEnd = line.find(' ', functionStart);
+            if (functionEnd == std::string_view::npos || functionEnd + 1 >= line.size() ||
+                line[functionEnd + 1] != '(') {
+                continue;
+            }
+            size_t argsEnd = line.find(')', functionEnd + 2);
+            if (argsEnd == std::string_view::npos ||
+                line.compare(argsEnd + 1, AT.size(), AT) != 0) {
+                continue;
+            }
+            size_t fileStart = argsEnd + 1 + AT.size();
+            if (fileStart > colonPos ||
+                line.substr(fileStart, colonPos - fileStart).find(':') != std::string_view::npos) {
+                continue;
+            }
+            frame.function = line.substr(functionStart, functionEnd - functionStart);
+            frame.file = line.substr(fileStart, colonPos - fileStart);
+            return frame;
+        }
+        return std::nullopt;
+    }
+
+    SarifStreamWriter::SarifStreamWriter(fs::path reportPath) : reportPath(std::move(reportPath)) {
+        json sarifJson;
+        sarifJson["$schema"] = "https://schemastore.azurewebsites.net/schemas/json/sarif-2.1.0-rtm.5.json";
+        sarifJson["version"] = "2.1.0";
+        {
+            json runs;
+            {
+                json runAkaTestCase;
+                runAkaTestCase["tool"]["driver"]["name"] = "UTBotCpp";
+                runAkaTestCase["tool"]["driver"]["informationUri"] = "https://utbot.org";
+                runAkaTestCase["results"] = json::array();
+                runs.push_back(runAkaTestCase);
+            }
+            sarifJson["runs"] = runs;
+        }
+        // the skeleton is split around the results array, which is filled in between
+        const std::string skeleton = sarifJson.dump(2);
+        const std::string RESULTS_OPEN = "\"results\": [";
+        size_t resultsEnd = skeleton.find(RESULTS_OPEN) + RESULTS_OPEN.size();
+        suffix = skeleton.substr(resultsEnd);
+
+        fs::create_directories(this->reportPath.parent_path());
+        stream.open(this->reportPath);
+        write(std::string_view(skeleton).substr(0, resultsEnd));
+    }
+
+    SarifStreamWriter::~SarifStreamWriter() {
+        if (!closed) {
+            stream.close();
+            // destructor must not throw, so std::filesystem is used for the error code
+            std::error_code ec;
+            std::filesystem::remove(reportPath.string(), ec);
+        }
+    }
+
+    void SarifStreamWriter::write(std::string_view text) {
+        stream.write(text.data(), text.size());
+        hasher.update(text);
+    }
+
+    void SarifStreamWriter::writeResult(const json &result) {
+        // results are the elements of $.runs[0].results, so they are indented by 8 spaces
+        const std::string RESULT_INDENT(8, ' ');
+        write(resultsCount == 0 ? "\n" : ",\n");
+        write(RESULT_INDENT);
+        // string values are escaped, so every line break of the dump starts a new line
+        const std::string dumped = result.dump(2);
+        size_t lineStart = 0;
+        for (size_t lineEnd = dumped.find('\n'); lineEnd != std::string::npos;
+             lineEnd = dumped.find('\n', lineStart)) {
+            write(std::string_view(dumped).substr(lineStart, lineEnd - lineStart + 1));
+            write(RESULT_INDENT);
+            lineStart = lineEnd + 1;
+        }
+        write(std::string_view(dumped).substr(lineStart));
+        ++resultsCount;
+    }
+
+    const fs::path &SarifStreamWriter::close() {
+        if (resultsCount > 0) {
+            // closing bracket of results array
+            write("\n      ");
+        }
+        write(suffix);
+        stream.close();
+        if (!stream) {
+            std::error_code ec(errno, std::system_category());
+            throw FileSystemException(
+                fs::filesystem_error("writing to file failed, file: " + reportPath.string(), ec));
+        }
+        closed = true;
+        return reportPath;
+    }
+
+    std::string SarifStreamWriter::contentHash() const {
+        return hasher.hexDigest();
+    }
+
+    void SarifStreamWriter::addTestsToResults(const utbot::ProjectContext &projectContext,
+                                              const Tests &tests) {
         LOG_SCOPE_FUNCTION(DEBUG);
         for (const auto &it : tests.methods) {
             for (const auto &methodTestCase : it.second.testCases) {
@@ -67,13 +204,11 @@ namespace sarif {
                             continue;
                         if (isspace(lineInDescriptor[0])) {
                             if (key == "Stack") {
-                                const std::regex stack_regex(
-                                    R"regex(\s+#(.*) in ([^ ]*) [(][^)]*[)] at ([^:]*):(\d+))regex");
-                                std::smatch stack_match;
-                                if (!std::regex_match(lineInDescriptor, stack_match, stack_regex)) {
+                                auto frame = parseStackFrame(lineInDescriptor);
+                                if (!frame.has_value()) {
                                     LOG_S(ERROR) << "wrong `Stack` line: " << lineInDescriptor;
                                 } else {
-                                    const fs::path &srcPath = fs::path(stack_match[3]);
+                                    const fs::path &srcPath = fs::path(std::string(frame->file));
                                     const fs::path &relPathInProject = getInProjectPath(projectContext.projectPath, srcPath);
                                     const fs::path &fullPathInProject = projectContext.projectPath / relPathInProject;
                                     if (Paths::isSubPathOf(projectContext.buildDir(), fullPathInProject)) {
@@ -88,10 +223,10 @@ namespace sarif {
                                             json location;
                                             location["physicalLocation"]["artifactLocation"]["uri"] = relPathInProject;
                                             location["physicalLocation"]["artifactLocation"]["uriBaseId"] = "%SRCROOT%";
-                                            location["physicalLocation"]["region"]["startLine"] = std::stoi(stack_match[4]); // line number
+                                            location["physicalLocation"]["region"]["startLine"] = frame->line; // line number
                                             // commented, duplicated in message
-                                            // location["logicalLocations"][0]["fullyQualifiedName"] = stack_match[2]; // call name
-                                            location["message"]["text"] = stack_match[2].str() + std::string(" (source)"); // info for ANALYSIS STEP
+                                            // location["logicalLocations"][0]["fullyQualifiedName"] = frame->function; // call name
+                                            location["message"]["text"] = std::string(frame->function) + " (source)"; // info for ANALYSIS STEP
                                             if (firstCallInStack) {
                                                 firstCallInStack = false;
                                                 result["locations"].push_back(location);
@@ -110,10 +245,10 @@ namespace sarif {
                                             json location;
                                             location["physicalLocation"]["artifactLocation"] ["uri"] = srcPath.filename(); // just a name
                                             location["physicalLocation"]["artifactLocation"] ["uriBaseId"] = "%PATH%";
-                                            location["physicalLocation"]["region"]["startLine"] = std::stoi(stack_match[4]); // line number
+                                            location["physicalLocation"]["region"]["startLine"] = frame->line; // line number
                                             // commented, duplicated in message
-                                            // location["logicalLocations"][0]["fullyQualifiedName"] = stack_match[2]; // call name
-                                            location["message"]["text"] = stack_match[2].str() + std::string(" (external)"); // info for ANALYSIS STEP
+                                            // location["logicalLocations"][0]["fullyQualifiedName"] = frame->function; // call name
+                                            location["message"]["text"] = std::string(frame->function) + " (external)"; // info for ANALYSIS STEP
                                             locationWrapper["location"] = location;
                                         }
                                         stackLocations["frames"].push_back(locationWrapper);
@@ -177,27 +312,9 @@ namespace sarif {
                 if (canAddThisTestToSARIF) {
                     result["stacks"].push_back(stackLocations);
                     result["codeFlows"][0]["threadFlows"].push_back(codeFlowsLocations);
-                    results.push_back(result);
+                    writeResult(result);
                 }
             }
         }
     }
-
-    std::string sarifPackResults(const json &results) {
-        json sarifJson;
-        sarifJson["$schema"] = "https://schemastore.azurewebsites.net/schemas/json/sarif-2.1.0-rtm.5.json";
-        sarifJson["version"] = "2.1.0";
-        {
-            json runs;
-            {
-                json runAkaTestCase;
-                runAkaTestCase["tool"]["driver"]["name"] = "UTBotCpp";
-                runAkaTestCase["tool"]["driver"]["informationUri"] = "https://utbot.org";
-                runAkaTestCase["results"] = results;
-                runs.push_back(runAkaTestCase);
-            }
-            sarifJson["runs"] = runs;
-        }
-        return sarifJson.dump(2);
-    }
 }
@@ -1,5 +1,10 @@
 #include "Tests.h"
 #include "ProjectContext.h"
+#include "utils/HashUtils.h"
+
+#include <fstream>
+#include <optional>
+#include <string_view>
 
 namespace sarif {
     const std::string PREFIX_FOR_JSON_PATH = "// UTBOT_TEST_GENERATOR (function name,test index): ";
@@ -12,8 +17,70 @@ namespace sarif {
     const std::string SARIF_DIR_NAME = "codeAnalysis";
     const std::string SARIF_FILE_NAME = "project_code_analysis.sarif";
 
-    void sarifAddTestsToResults(const utbot::ProjectContext &projectContext,
-                                const tests::Tests &tests,
-                                nlohmann::json &results);
-    std::string sarifPackResults(const nlohmann::json &results);
+    /**
+     * Frame of KLEE stack trace, e.g.
+     * "    #100000123 in foo (a=1) at /path/to/source.c:42".
+     * Views point into the parsed line.
+     */
+    struct StackFrame {
+        std::string_view function;
+        std::string_view file;
+        int line;
+    };
+
+    /**
+     * Parses stack frame line of `XXXX.err` file. Accepts the same lines as regular expression
+     * \s+#(.*) in ([^ ]*) [(][^)]*[)] at ([^:]*):(\d+)
+     * and extracts the same groups.
+     * @return std::nullopt if line is not a stack frame.
+     */
+    std::optional<StackFrame> parseStackFrame(std::string_view line);
+
+    /**
+     * Writes SARIF report result by result. Results are written to the file as soon as
+     * the tests are processed, so only the result being built is kept in memory. The output
+     * is the same as pretty printed nlohmann::json of the whole report.
+     */
+    class SarifStreamWriter {
+    public:
+        /**
+         * @param reportPath file to which the report is streamed.
+         */
+        explicit SarifStreamWriter(fs::path reportPath);
+
+        SarifStreamWriter(const SarifStreamWriter &) = delete;
+        SarifStreamWriter &operator=(const SarifStreamWriter &) = delete;
+
+        /**
+         * Removes the report file if the report was not closed, e.g. when generation was
+         * cancelled or failed, so that no partial report is left behind.
+         */
+        ~SarifStreamWriter();
+
+        void addTestsToResults(const utbot::ProjectContext &projectContext,
+                               const tests::Tests &tests);
+
+        /**
+         * Finishes the report. No results may be added after that.
+         * @return path to the complete report.
+         */
+        const fs::path &close();
+
+        /**
+         * @return HashUtils::contentHash of the closed report, computed while it was written.
+         */
+        [[nodiscard]] std::string contentHash() const;
+
+    private:
+        fs::path reportPath;
+        std::ofstream stream;
+        std::string suffix;
+        size_t resultsCount = 0;
+        bool closed = false;
+        HashUtils::ContentHasher hasher;
+
+        void write(std::string_view text);
+
+        void writeResult(const nlohmann::json &result);
+    };
 }
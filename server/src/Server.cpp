@@ -8,6 +8,7 @@
 #include "Synchronizer.h"
 #include "Version.h"
 #include "building/Linker.h"
+#include "building/ProjectSnapshot.h"
 #include "building/UserProjectConfiguration.h"
 #include "clang-utils/SourceToHeaderRewriter.h"
 #include "coverage/CoverageAndResultsGenerator.h"
@@ -58,21 +59,68 @@ void Server::run(uint16_t customPort) {
 
     ServerBuilder builder;
     builder.AddListeningPort(address, grpc::InsecureServerCredentials());
-    builder.RegisterService(&testsService);
+    builder.RegisterService(&asyncService);
     if (ServerUtils::checkPort(host, port)) {
         LOG_S(INFO) << "Address: " << address << std::endl;
+        for (size_t i = 0; i < POLLING_THREADS_COUNT; ++i) {
+            completionQueues.push_back(builder.AddCompletionQueue());
+        }
         /* Launches the watcher in a separate thread that releases
          * unused grpc::ServerWriter<> resources.
          */
         logChannelsWatcherTask =
                 std::async(std::launch::async, LogUtils::logChannelsWatcher, std::ref(*this));
+        generationPool = std::make_unique<ThreadPool>(getWorkersCount());
+        metadataPool = std::make_unique<ThreadPool>(METADATA_WORKERS_COUNT);
+        controlPool = std::make_unique<ThreadPool>(CONTROL_WORKERS_COUNT);
+        LOG_S(INFO) << "Workers count: " << generationPool->size();
         gRPCServer = builder.BuildAndStart();
+        for (const auto &completionQueue : completionQueues) {
+            listenCalls(completionQueue.get());
+            pollingThreads.emplace_back(utbot::pollCompletionQueue, completionQueue.get());
+        }
         gRPCServer->Wait();
+
+        // handlers may still wait for their writes, so queues are polled until workers finish
+        testsService.closeLogChannels();
+        joinChannelThreads();
+        generationPool.reset();
+        metadataPool.reset();
+        controlPool.reset();
+        for (const auto &completionQueue : completionQueues) {
+            completionQueue->Shutdown();
+        }
+        for (auto &pollingThread : pollingThreads) {
+            pollingThread.join();
+        }
+        pollingThreads.clear();
+        completionQueues.clear();
     } else {
         LOG_S(ERROR) << "Port unavailable: " << port << std::endl;
     }
 }
 
+void Server::shutdown() {
+    if (gRPCServer) {
+        // log channels never finish by themselves, so they are released before waiting for calls
+        testsService.closeLogChannels();
+        gRPCServer->Shutdown(std::chrono::system_clock::now() + SHUTDOWN_TIMEOUT);
+    }
+}
+
+void Server::joinChannelThreads() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(channelThreadsMutex);
+        threads.swap(channelThreads);
+    }
+    for (auto &thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
 uint16_t Server::getPort() {
     if (const char *envPort = std::getenv("UTBOT_SERVER_PORT")) {
         return std::stoi(envPort);
@@ -80,6 +128,140 @@ uint16_t Server::getPort() {
     return DEFAULT_PORT;
 }
 
+size_t Server::getWorkersCount() {
+    if (const char *envWorkers = std::getenv("UTBOT_SERVER_WORKERS")) {
+        return std::max(1, std::stoi(envWorkers));
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+template <typename Service, typename Request, typename Response>
+void Server::listenUnaryCall(
+    void (Service::*requestMethod)(ServerContext *,
+                                   Request *,
+                                   grpc::ServerAsyncResponseWriter<Response> *,
+                                   grpc::CompletionQueue *,
+                                   grpc::ServerCompletionQueue *,
+                                   void *),
+    Status (TestsGenServiceImpl::*handler)(ServerContext *, const Request *, Response *),
+    const utbot::CallExecutor &executor,
+    grpc::ServerCompletionQueue *completionQueue) {
+    utbot::AsyncUnaryCall<Request, Response>::listen(
+        [this, requestMethod](ServerContext *context, Request *request,
+                              grpc::ServerAsyncResponseWriter<Response> *responder,
+                              grpc::ServerCompletionQueue *completionQueue, void *tag) {
+            (asyncService.*requestMethod)(context, request, responder, completionQueue,
+                                          completionQueue, tag);
+        },
+        [this, handler](ServerContext *context, const Request *request, Response *response) {
+            return (testsService.*handler)(context, request, response);
+        },
+        executor, completionQueue);
+}
+
+template <typename Service, typename Request, typename Response>
+void Server::listenServerStreamingCall(
+    void (Service::*requestMethod)(ServerContext *,
+                                   Request *,
+                                   grpc::ServerAsyncWriter<Response> *,
+                                   grpc::CompletionQueue *,
+                                   grpc::ServerCompletionQueue *,
+                                   void *),
+    Status (TestsGenServiceImpl::*handler)(ServerContext *,
+                                           const Request *,
+                                           ServerWriterInterface<Response> *),
+    const utbot::CallExecutor &executor,
+    grpc::ServerCompletionQueue *completionQueue) {
+    utbot::AsyncServerStreamingCall<Request, Response>::listen(
+        [this, requestMethod](ServerContext *context, Request *request,
+                              grpc::ServerAsyncWriter<Response> *responder,
+                              grpc::ServerCompletionQueue *completionQueue, void *tag) {
+            (asyncService.*requestMethod)(context, request, responder, completionQueue,
+                                          completionQueue, tag);
+        },
+        [this, handler](ServerContext *context, const Request *request,
+                        ServerWriterInterface<Response> *writer) {
+            return (testsService.*handler)(context, request, writer);
+        },
+        executor, completionQueue);
+}
+
+void Server::listenCalls(grpc::ServerCompletionQueue *completionQueue) {
+    using AsyncService = TestsGenService::AsyncService;
+    using Impl = TestsGenServiceImpl;
+
+    // short calls are not run on the polling thread: their logs are written to log channels,
+    // and the writes wait for tags that only the polling thread delivers
+    utbot::CallExecutor controlWorker = [this](std::function<void()> handler) {
+        controlPool->submit(std::move(handler));
+    };
+    // log channels are held open while the client is alive, so they don't occupy workers
+    utbot::CallExecutor dedicatedThread = [this](std::function<void()> handler) {
+        std::lock_guard<std::mutex> lock(channelThreadsMutex);
+        channelThreads.emplace_back(std::move(handler));
+    };
+    utbot::CallExecutor metadataWorker = [this](std::function<void()> handler) {
+        metadataPool->submit(std::move(handler));
+    };
+    utbot::CallExecutor generationWorker = [this](std::function<void()> handler) {
+        generationPool->submit(std::move(handler));
+    };
+
+    listenUnaryCall(&AsyncService::RequestHandshake, &Impl::Handshake, controlWorker,
+                    completionQueue);
+    listenUnaryCall(&AsyncService::RequestHeartbeat, &Impl::Heartbeat, controlWorker,
+                    completionQueue);
+    listenUnaryCall(&AsyncService::RequestRegisterClient, &Impl::RegisterClient, controlWorker,
+                    completionQueue);
+    listenUnaryCall(&AsyncService::RequestCloseLogChannel, &Impl::CloseLogChannel, controlWorker,
+                    completionQueue);
+    listenUnaryCall(&AsyncService::RequestCloseGTestChannel, &Impl::CloseGTestChannel,
+                    controlWorker, completionQueue);
+
+    listenServerStreamingCall(&AsyncService::RequestOpenLogChannel, &Impl::OpenLogChannel,
+                              dedicatedThread, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestOpenGTestChannel, &Impl::OpenGTestChannel,
+                              dedicatedThread, completionQueue);
+
+    listenUnaryCall(&AsyncService::RequestGetFunctionReturnType, &Impl::GetFunctionReturnType,
+                    metadataWorker, completionQueue);
+    listenUnaryCall(&AsyncService::RequestPrintModulesContent, &Impl::PrintModulesContent,
+                    metadataWorker, completionQueue);
+    listenUnaryCall(&AsyncService::RequestGetSourceCode, &Impl::GetSourceCode, metadataWorker,
+                    completionQueue);
+    listenUnaryCall(&AsyncService::RequestGetProjectTargets, &Impl::GetProjectTargets,
+                    metadataWorker, completionQueue);
+    listenUnaryCall(&AsyncService::RequestGetFileTargets, &Impl::GetFileTargets, metadataWorker,
+                    completionQueue);
+
+    listenServerStreamingCall(&AsyncService::RequestGenerateSnippetTests,
+                              &Impl::GenerateSnippetTests, generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateProjectTests,
+                              &Impl::GenerateProjectTests, generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateFileTests, &Impl::GenerateFileTests,
+                              generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateFunctionTests,
+                              &Impl::GenerateFunctionTests, generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateClassTests, &Impl::GenerateClassTests,
+                              generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateFolderTests,
+                              &Impl::GenerateFolderTests, generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateLineTests, &Impl::GenerateLineTests,
+                              generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateAssertionFailTests,
+                              &Impl::GenerateAssertionFailTests, generationWorker,
+                              completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGeneratePredicateTests,
+                              &Impl::GeneratePredicateTests, generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestCreateTestsCoverageAndResult,
+                              &Impl::CreateTestsCoverageAndResult, generationWorker,
+                              completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestGenerateProjectStubs,
+                              &Impl::GenerateProjectStubs, generationWorker, completionQueue);
+    listenServerStreamingCall(&AsyncService::RequestConfigureProject, &Impl::ConfigureProject,
+                              generationWorker, completionQueue);
+}
+
 Server::Server() {
 }
 
@@ -87,12 +269,15 @@ Server::Server(bool testMode) : testsService(testMode) {
 }
 
 Server::~Server() {
+    shutdown();
+    joinChannelThreads();
     if (logChannelsWatcherTask.valid()) {
-        logChannelsWatcherCancellationToken = true;
-        std::future_status status;
-        do {
-            status = logChannelsWatcherTask.wait_for(TimeUtils::IDLE_TIMEOUT);
-        } while (status != std::future_status::ready);
+        {
+            std::lock_guard<std::mutex> lock(logChannelsWatcherMutex);
+            logChannelsWatcherCancellationToken = true;
+        }
+        logChannelsWatcherCondition.notify_all();
+        logChannelsWatcherTask.wait();
     }
 }
 
@@ -106,54 +291,54 @@ Server::TestsGenServiceImpl::TestsGenServiceImpl(bool testMode) : TestsGenServic
 
 Status Server::TestsGenServiceImpl::GenerateSnippetTests(ServerContext *context,
                                                          const SnippetRequest *request,
-                                                         ServerWriter<TestsResponse> *writer) {
+                                                         ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<SnippetTestGen, SnippetRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GenerateProjectTests(ServerContext *context,
                                                          const ProjectRequest *request,
-                                                         ServerWriter<TestsResponse> *writer) {
+                                                         ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<ProjectTestGen, ProjectRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GenerateFileTests(ServerContext *context,
                                                       const FileRequest *request,
-                                                      ServerWriter<TestsResponse> *writer) {
+                                                      ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<FileTestGen, FileRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GenerateFunctionTests(ServerContext *context,
                                                           const FunctionRequest *request,
-                                                          ServerWriter<TestsResponse> *writer) {
+                                                          ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<FunctionTestGen, FunctionRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GenerateClassTests(ServerContext *context,
                                                        const ClassRequest *request,
-                                                       ServerWriter<TestsResponse> *writer) {
+                                                       ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<ClassTestGen, ClassRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GenerateFolderTests(ServerContext *context,
                                                         const FolderRequest *request,
-                                                        ServerWriter<TestsResponse> *writer) {
+                                                        ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<FolderTestGen, FolderRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GenerateLineTests(ServerContext *context,
                                                       const LineRequest *request,
-                                                      ServerWriter<TestsResponse> *writer) {
+                                                      ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<LineTestGen, LineRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GenerateAssertionFailTests(
-    ServerContext *context, const AssertionRequest *request, ServerWriter<TestsResponse> *writer) {
+    ServerContext *context, const AssertionRequest *request, ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<AssertionTestGen, AssertionRequest>(context, *request, writer);
 }
 
 Status Server::TestsGenServiceImpl::GeneratePredicateTests(ServerContext *context,
                                                            const PredicateRequest *request,
-                                                           ServerWriter<TestsResponse> *writer) {
+                                                           ServerWriterInterface<TestsResponse> *writer) {
     return BaseTestGenerate<PredicateTestGen, PredicateRequest>(context, *request, writer);
 }
 
@@ -168,7 +353,7 @@ Status Server::TestsGenServiceImpl::Handshake(ServerContext *context,
 Status Server::TestsGenServiceImpl::CreateTestsCoverageAndResult(
     ServerContext *context,
     const CoverageAndResultsRequest *request,
-    ServerWriter<CoverageAndResultsResponse> *writer) {
+    ServerWriterInterface<CoverageAndResultsResponse> *writer) {
     LOG_S(INFO) << "CreateTestsCoverageAndResult receive:\n" << request->DebugString();
 
     auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(writer);
@@ -195,12 +380,54 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
         auto preprocessingStartTime = std::chrono::steady_clock::now();
         types::TypesHandler::SizeContext sizeContext;
 
+        // the line is resolved first, so only the selected function is fetched and processed
+        std::shared_ptr<LineInfo> lineInfo = nullptr;
+        auto lineTestGen = dynamic_cast<LineTestGen *>(&testGen);
+        Fetcher::FunctionFilter functionFilter;
+        if (lineTestGen != nullptr) {
+            if (isSameType<ClassTestGen>(testGen) && Paths::isHeaderFile(lineTestGen->filePath)) {
+                BordersFinder classFinder(lineTestGen->filePath, lineTestGen->line,
+                                          lineTestGen->compilationDatabase,
+                                          lineTestGen->compileCommandsJsonPath);
+                classFinder.findClass();
+                lineInfo = std::make_shared<LineInfo>(classFinder.getLineInfo());
+                lineInfo->filePath = lineTestGen->getSourcePath();
+                // only methods of other classes of the requested file are skipped
+                functionFilter = [&lineInfo](const fs::path &sourceFilePath,
+                                             const clang::FunctionDecl *functionDecl) {
+                    if (sourceFilePath != lineInfo->filePath || !functionDecl->isCXXClassMember()) {
+                        return true;
+                    }
+                    const auto *record = llvm::dyn_cast<clang::CXXRecordDecl>(functionDecl->getParent());
+                    if (record == nullptr) {
+                        return true;
+                    }
+                    // the same name as the one of the class object of the method
+                    const clang::QualType classType = record->getTypeForDecl()->getCanonicalTypeInternal();
+                    return ParamsHandler::getType(classType, classType,
+                                                  functionDecl->getASTContext().getSourceManager())
+                               .typeName() == lineInfo->scopeName;
+                };
+            } else {
+                lineInfo = getLineInfo(*lineTestGen);
+                // only the function of the requested file is fetched, others are kept as is
+                functionFilter = [&lineInfo](const fs::path &sourceFilePath,
+                                             const clang::FunctionDecl *functionDecl) {
+                    return sourceFilePath != lineInfo->filePath ||
+                           (functionDecl->getNameAsString() == lineInfo->methodName &&
+                            BordersFinder::getScopeName(functionDecl, sourceFilePath) ==
+                                lineInfo->scopeName);
+                };
+            }
+        }
+
         static std::string logMessage = "Traversing sources AST tree and fetching declarations.";
         LOG_S(DEBUG) << logMessage;
         Fetcher fetcher(Fetcher::Options::Value::ALL,
                         testGen.compilationDatabase, testGen.tests, &testGen.types,
                         &sizeContext.pointerSize, &sizeContext.maximumAlignment,
                         testGen.compileCommandsJsonPath, false);
+        fetcher.setFunctionFilter(functionFilter);
         fetcher.fetchWithProgress(testGen.progressWriter, logMessage);
         SourceToHeaderRewriter(testGen.projectContext, testGen.compilationDatabase,
                                fetcher.getStructsToDeclare(), testGen.serverBuildDir)
@@ -212,31 +439,6 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
         Synchronizer synchronizer(&testGen, &stubGen, &sizeContext);
         synchronizer.synchronize(typesHandler);
 
-        std::shared_ptr<LineInfo> lineInfo = nullptr;
-        auto lineTestGen = dynamic_cast<LineTestGen *>(&testGen);
-
-        if (lineTestGen != nullptr) {
-            if (isSameType<ClassTestGen>(testGen) && Paths::isHeaderFile(lineTestGen->filePath)) {
-                BordersFinder classFinder(lineTestGen->filePath, lineTestGen->line,
-                                          lineTestGen->compilationDatabase,
-                                          lineTestGen->compileCommandsJsonPath);
-                classFinder.findClass();
-                lineInfo = std::make_shared<LineInfo>(classFinder.getLineInfo());
-                lineInfo->filePath = lineTestGen->getSourcePath();
-                CollectionUtils::erase_if(testGen.tests.at(lineInfo->filePath).methods,
-                                          [&lineInfo](const tests::Tests::MethodDescription &methodDescription) {
-                                              return methodDescription.isClassMethod() &&
-                                                     methodDescription.classObj->type.typeName() != lineInfo->scopeName;
-                                          });
-            } else {
-                lineInfo = getLineInfo(*lineTestGen);
-                CollectionUtils::erase_if(testGen.tests.at(lineInfo->filePath).methods,
-                                          [&lineInfo](const auto &methodDescription) {
-                                              return methodDescription.name != lineInfo->methodName;
-                                          });
-            }
-        }
-
         FeaturesFilter::filter(testGen.settingsContext, typesHandler, testGen.tests);
         StubsCollector(typesHandler).collect(testGen.tests);
 
@@ -258,8 +460,6 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
             testGen.serverBuildDir, testGen.compilationDatabase, typesHandler,
             pathSubstitution, testGen.buildDatabase, testGen.progressWriter);
 
-        ReturnTypesFetcher returnTypesFetcher{ &testGen };
-        returnTypesFetcher.fetch(testGen.progressWriter, synchronizer.getAllFiles());
         LOG_S(DEBUG) << "Temporary build directory path: " << testGen.serverBuildDir;
         generator->buildKleeFiles(testGen.tests, lineInfo);
         generator->handleFailedFunctions(testGen.tests);
@@ -267,6 +467,13 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
         Linker linker{ testGen, stubGen, lineInfo, generator };
         linker.prepareArtifacts();
         auto testMethods = linker.getTestMethods();
+        // return types are needed only for symbolic return values of stubs
+        auto stubbedSources = CollectionUtils::filterOut(
+            linker.getStubbedSources(), [&synchronizer](fs::path const &sourcePath) {
+                return !CollectionUtils::contains(synchronizer.getAllFiles(), sourcePath);
+            });
+        ReturnTypesFetcher returnTypesFetcher{ &testGen };
+        returnTypesFetcher.fetch(testGen.progressWriter, stubbedSources);
         KleeRunner kleeRunner{ testGen.projectContext, testGen.settingsContext,
                                testGen.serverBuildDir };
         bool interactiveMode = (dynamic_cast<ProjectTestGen *>(&testGen) != nullptr);
@@ -309,29 +516,32 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
     return Status::OK;
 }
 
-std::shared_ptr<LineInfo> Server::TestsGenServiceImpl::getLineInfo(LineTestGen &lineTestGen) {
-    BordersFinder stmtFinder(lineTestGen.filePath, lineTestGen.line,
-                             lineTestGen.compilationDatabase,
-                             lineTestGen.compileCommandsJsonPath);
+LineInfo Server::TestsGenServiceImpl::findLineInfo(
+    const fs::path &filePath,
+    unsigned line,
+    const std::shared_ptr<CompilationDatabase> &compilationDatabase,
+    const fs::path &compileCommandsJsonPath) {
+    BordersFinder stmtFinder(filePath, line, compilationDatabase, compileCommandsJsonPath);
     stmtFinder.findFunction();
     if (!stmtFinder.getLineInfo().initialized) {
         throw NoTestGeneratedException(
             "Maybe you tried to generate tests placing cursor on invalid line.");
     }
+    return stmtFinder.getLineInfo();
+}
+
+std::shared_ptr<LineInfo> Server::TestsGenServiceImpl::getLineInfo(LineTestGen &lineTestGen) {
+    auto lineInfo = std::make_shared<LineInfo>(
+        findLineInfo(lineTestGen.filePath, lineTestGen.line, lineTestGen.compilationDatabase,
+                     lineTestGen.compileCommandsJsonPath));
     if (isSameType<AssertionTestGen>(lineTestGen) &&
-        !StringUtils::contains(stmtFinder.getLineInfo().stmtString, "assert")) {
+        !StringUtils::contains(lineInfo->stmtString, "assert")) {
         throw NoTestGeneratedException("No assert found on this line.");
     }
-    auto lineInfo = std::make_shared<LineInfo>(stmtFinder.getLineInfo());
     if (auto predicateInfo = dynamic_cast<PredicateTestGen *>(&lineTestGen)) {
         lineInfo->predicateInfo = LineInfo::PredicateInfo(
             { predicateInfo->type, predicateInfo->predicate, predicateInfo->returnValue });
     }
-    auto &methods = lineTestGen.tests.at(lineInfo->filePath).methods;
-    CollectionUtils::erase_if(methods, [&lineInfo](auto const &method) {
-        return (lineInfo->forMethod && method.name != lineInfo->methodName) ||
-               (lineInfo->forClass && method.isClassMethod() && method.classObj->type.typeName() != lineInfo->scopeName);
-    });
     return lineInfo;
 }
 
@@ -385,7 +595,7 @@ loguru::Verbosity MaxNameToVerbosityCallback(const char* name) {
 
 Status Server::TestsGenServiceImpl::provideLoggingCallbacks(
     const std::string &callbackPrefix,
-    ServerWriter<LogEntry> *writer,
+    ServerWriterInterface<LogEntry> *writer,
     const std::string &logLevel,
     loguru::log_handler_t handler,
     std::map<std::string, std::atomic_bool> &channelStorage,
@@ -420,7 +630,8 @@ Status Server::TestsGenServiceImpl::provideLoggingCallbacks(
          * 1. Using gRPC async API
          * 2. Issuing a request from UTBot to a specific client on every log entry.
          */
-        while (holdLockFlag[callbackName].exchange(true, std::memory_order_acquire)) {
+        while (holdLockFlag[callbackName].exchange(true, std::memory_order_acquire) &&
+               !RequestEnvironment::isCancelled()) {
             std::this_thread::yield();
         }
         loguru::remove_callback(callbackName.c_str());
@@ -435,7 +646,7 @@ Status Server::TestsGenServiceImpl::provideLoggingCallbacks(
 
 Status Server::TestsGenServiceImpl::OpenLogChannel(ServerContext *context,
                                                    const LogChannelRequest *request,
-                                                   ServerWriter<LogEntry> *writer) {
+                                                   ServerWriterInterface<LogEntry> *writer) {
     ServerUtils::setThreadOptions(context, testMode);
     return provideLoggingCallbacks(logPrefix, writer, request->loglevel(), logToClient, openedChannel,
                                    true);
@@ -450,9 +661,16 @@ Status Server::TestsGenServiceImpl::CloseLogChannel(ServerContext *context,
     return Status::OK;
 }
 
+void Server::TestsGenServiceImpl::closeLogChannels() {
+    const std::lock_guard<std::mutex> lock(logChannelOperationsMutex);
+    for (auto &[callbackName, flag] : holdLockFlag) {
+        flag.store(false, std::memory_order_release);
+    }
+}
+
 Status Server::TestsGenServiceImpl::OpenGTestChannel(ServerContext *context,
                                                      const LogChannelRequest *request,
-                                                     ServerWriter<LogEntry> *writer) {
+                                                     ServerWriterInterface<LogEntry> *writer) {
     ServerUtils::setThreadOptions(context, testMode);
     return provideLoggingCallbacks(gtestLogPrefix, writer, request->loglevel(), gtestLog,
                                    openedGTestChannel, false);
@@ -496,13 +714,23 @@ Status Server::TestsGenServiceImpl::GetFunctionReturnType(ServerContext *context
     LOG_S(INFO) << "GetFunctionReturnType receive:\n" << request->DebugString();
 
     ServerUtils::setThreadOptions(context, testMode);
-    auto lock = acquireLock();
 
     MEASURE_FUNCTION_EXECUTION_TIME
 
-    LineTestGen testGen(request->linerequest(), nullptr, testMode);
-    auto lineInfo = getLineInfo(testGen);
-    const auto &type = lineInfo->functionReturnType;
+    std::shared_ptr<const ProjectSnapshot> snapshot;
+    try {
+        utbot::ProjectContext projectContext{
+            request->linerequest().projectrequest().projectcontext()
+        };
+        snapshot = ProjectSnapshot::get(projectContext);
+    } catch (CompilationDatabaseException const &e) {
+        return failedToLoadCDbStatus(e);
+    }
+    const auto &sourceInfo = request->linerequest().sourceinfo();
+    LineInfo lineInfo = findLineInfo(fs::weakly_canonical(sourceInfo.filepath()),
+                                     sourceInfo.line(), snapshot->compilationDatabase,
+                                     snapshot->compileCommandsJsonPath);
+    const auto &type = lineInfo.functionReturnType;
     testsgen::ValidationType typeResponse = testsgen::UNSUPPORTED;
     if (types::TypesHandler::isIntegerType(type)) {
         typeResponse = types::TypesHandler::getIntegerValidationType(type);
@@ -522,14 +750,15 @@ Status Server::TestsGenServiceImpl::GetFunctionReturnType(ServerContext *context
 
 Status Server::TestsGenServiceImpl::GenerateProjectStubs(ServerContext *context,
                                                          const ProjectRequest *request,
-                                                         ServerWriter<StubsResponse> *writer) {
+                                                         ServerWriterInterface<StubsResponse> *writer) {
     try {
         LOG_S(INFO) << "GenerateProjectStubs receive:\n" << request->DebugString();
 
-        auto stubsWriter =
-            std::make_unique<ServerStubsWriter>(writer, GrpcUtils::synchronizeCode(*request));
+        auto stubsWriter = std::make_unique<ServerStubsWriter>(
+            writer, GrpcUtils::synchronizeCode(*request), request->transferoptions());
 
         ServerUtils::setThreadOptions(context, testMode);
+        ServerUtils::setTransferOptions(context, request->transferoptions());
         auto lock = acquireLock(stubsWriter.get());
 
         MEASURE_FUNCTION_EXECUTION_TIME
@@ -556,8 +785,8 @@ Status Server::TestsGenServiceImpl::ProcessProjectStubsRequest(BaseTestGen *test
 
     fetcher.fetchWithProgress(testGen->progressWriter, logMessage);
     Synchronizer synchronizer(testGen, &stubGen, &sizeContext);
-    synchronizer.synchronize(typesHandler);
-    stubsWriter->writeResponse(testGen->synchronizedStubs, testGen->projectContext.testDirPath);
+    synchronizer.synchronize(typesHandler, stubsWriter);
+    stubsWriter->writeCompleted();
     return Status::OK;
 }
 
@@ -589,7 +818,6 @@ Status Server::TestsGenServiceImpl::GetSourceCode(ServerContext *context,
     LOG_S(INFO) << "GetSourceCode receive:\n" << request->DebugString();
 
     ServerUtils::setThreadOptions(context, testMode);
-    auto lock = acquireLock();
 
     MEASURE_FUNCTION_EXECUTION_TIME
 
@@ -607,7 +835,7 @@ Status Server::TestsGenServiceImpl::GetSourceCode(ServerContext *context,
 Status
 Server::TestsGenServiceImpl::ConfigureProject(ServerContext *context,
                                               const ProjectConfigRequest *request,
-                                              ServerWriter<ProjectConfigResponse> *response) {
+                                              ServerWriterInterface<ProjectConfigResponse> *response) {
     LOG_S(INFO) << "CheckProjectConfiguration receive:\n" << request->DebugString();
     ProjectConfigWriter writer{ response };
 
@@ -627,13 +855,14 @@ Server::TestsGenServiceImpl::ConfigureProject(ServerContext *context,
     case ConfigMode::GENERATE_JSON_FILES: {
         std::vector<std::string> cmakeOptions(request->cmakeoptions().begin(), request->cmakeoptions().end());
         return UserProjectConfiguration::RunProjectConfigurationCommands(
-                buildDirPath, utbotProjectContext, cmakeOptions, writer);
+                buildDirPath, utbotProjectContext, cmakeOptions, writer,
+                request->incrementalconfiguration());
     }
     case ConfigMode::ALL: {
         std::vector<std::string> cmakeOptions(request->cmakeoptions().begin(), request->cmakeoptions().end());
         return UserProjectConfiguration::RunProjectReConfigurationCommands(
                 buildDirPath, fs::path(utbotProjectContext.projectPath),
-                utbotProjectContext, cmakeOptions, writer);
+                utbotProjectContext, cmakeOptions, writer, request->incrementalconfiguration());
     }
     default:
         return {StatusCode::CANCELLED, "Invalid request type."};
@@ -647,14 +876,13 @@ Status Server::TestsGenServiceImpl::GetProjectTargets(ServerContext *context,
 
 
     ServerUtils::setThreadOptions(context, testMode);
-    auto lock = acquireLock();
 
     MEASURE_FUNCTION_EXECUTION_TIME
 
     try {
         utbot::ProjectContext projectContext{ request->projectcontext() };
-        auto buildDatabase = BuildDatabase::create(projectContext);
-        auto targets = buildDatabase->getAllTargets();
+        auto snapshot = ProjectSnapshot::get(projectContext);
+        auto targets = snapshot->buildDatabase->getAllTargets();
         ProjectTargetsWriter targetsWriter{ response };
         targetsWriter.writeResponse(projectContext, targets);
     } catch (CompilationDatabaseException const &e) {
@@ -669,15 +897,14 @@ Status Server::TestsGenServiceImpl::GetFileTargets(ServerContext *context,
     LOG_S(INFO) << "GetFileTargets receive:\n" << request->DebugString();
 
     ServerUtils::setThreadOptions(context, testMode);
-    auto lock = acquireLock();
 
     MEASURE_FUNCTION_EXECUTION_TIME
 
     try {
         utbot::ProjectContext projectContext{ request->projectcontext() };
-        auto buildDatabase = BuildDatabase::create(projectContext);
+        auto snapshot = ProjectSnapshot::get(projectContext);
         fs::path path = request->path();
-        auto targets = buildDatabase->getTargetsForSourceFile(path);
+        auto targets = snapshot->buildDatabase->getTargetsForSourceFile(path);
         FileTargetsWriter targetsWriter{ response };
         targetsWriter.writeResponse(targets, projectContext);
     } catch (CompilationDatabaseException const& e) {
@@ -1,6 +1,7 @@
 #ifndef UNITTESTBOT_SERVER_H
 #define UNITTESTBOT_SERVER_H
 
+#include "AsyncServerCalls.h"
 #include "KleeGenerator.h"
 #include "ThreadSafeContainers.h"
 #include "TimeExecStatistics.h"
@@ -25,6 +26,7 @@
 #include "utils/LogUtils.h"
 #include "utils/RequestLockMutex.h"
 #include "utils/ServerUtils.h"
+#include "utils/ThreadPool.h"
 #include "utils/TimeUtils.h"
 
 #include <grpcpp/grpcpp.h>
@@ -34,8 +36,11 @@
 #include "loguru.h"
 
 #include "utils/path/FileSystemPath.h"
+#include <condition_variable>
+#include <functional>
 #include <future>
 #include <string>
+#include <thread>
 #include <variant>
 #include <vector>
 
@@ -43,7 +48,7 @@ using json = nlohmann::json;
 
 using grpc::ServerBuilder;
 using grpc::ServerContext;
-using grpc::ServerWriter;
+using grpc::ServerWriterInterface;
 using grpc::Status;
 using grpc::StatusCode;
 
@@ -58,7 +63,12 @@ public:
 
     void run(uint16_t customPort = 0);
 
-    class TestsGenServiceImpl final : public TestsGenService::Service {
+    /**
+     * Stops accepting calls and makes run() return once the running calls are finished.
+     */
+    void shutdown();
+
+    class TestsGenServiceImpl final {
     public:
         TestsGenServiceImpl();
 
@@ -66,52 +76,58 @@ public:
 
         Status Handshake(ServerContext *context,
                          const VersionInfo *request,
-                         VersionInfo *response) override;
+                         VersionInfo *response);
 
         Status OpenLogChannel(ServerContext *context,
                               const LogChannelRequest *request,
-                              ServerWriter<LogEntry> *writer) override;
+                              ServerWriterInterface<LogEntry> *writer);
 
         Status CloseLogChannel(ServerContext *context,
                                const DummyRequest *request,
-                               DummyResponse *response) override;
+                               DummyResponse *response);
 
         Status OpenGTestChannel(ServerContext *context,
                                 const LogChannelRequest *request,
-                                ServerWriter<LogEntry> *writer) override;
+                                ServerWriterInterface<LogEntry> *writer);
 
         Status CloseGTestChannel(ServerContext *context,
                                const DummyRequest *request,
-                               DummyResponse *response) override;
+                               DummyResponse *response);
 
         Status Heartbeat(ServerContext *context,
                          const DummyRequest *request,
-                         HeartbeatResponse *response) override;
+                         HeartbeatResponse *response);
 
         Status PrintModulesContent(ServerContext *context,
                          const ProjectContext *request,
-                         DummyResponse *response) override;
+                         DummyResponse *response);
 
         Status RegisterClient(ServerContext *context,
                            const RegisterClientRequest *request,
-                           DummyResponse *response) override;
+                           DummyResponse *response);
 
         Status GetFunctionReturnType(ServerContext *context,
                                      const FunctionRequest *request,
-                                     FunctionTypeResponse *response) override;
+                                     FunctionTypeResponse *response);
 
         template <typename TestGenT, typename RequestT>
         Status BaseTestGenerate(ServerContext *context,
                                 RequestT const &request,
-                                ServerWriter<TestsResponse> *writer) {
+                                ServerWriterInterface<TestsResponse> *writer) {
             static_assert(std::is_base_of<BaseTestGen, TestGenT>::value,
                           "Type parameter must derive from BaseTestGen");
             try {
                 LOG_S(INFO) << typeid(RequestT).name() << " receive:\n" << request.DebugString();
-                auto testsWriter = std::make_unique<ServerTestsWriter>(writer, GrpcUtils::synchronizeCode(request));
+                auto transferOptions = GrpcUtils::transferOptions(request);
+                auto testsWriter = std::make_unique<ServerTestsWriter>(
+                    writer, GrpcUtils::synchronizeCode(request), transferOptions);
 
                 ServerUtils::setThreadOptions(context, testMode);
+                ServerUtils::setTransferOptions(context, transferOptions);
                 auto lock = acquireLock(testsWriter.get());
+                if (generationStartedHook) {
+                    generationStartedHook();
+                }
 
                 MEASURE_FUNCTION_EXECUTION_TIME
 
@@ -131,70 +147,81 @@ public:
 
         Status GenerateSnippetTests(ServerContext *context,
                                     const SnippetRequest *request,
-                                    ServerWriter<TestsResponse> *writer) override;
+                                    ServerWriterInterface<TestsResponse> *writer);
 
         Status GenerateProjectTests(ServerContext *context,
                                     const ProjectRequest *request,
-                                    ServerWriter<TestsResponse> *writer) override;
+                                    ServerWriterInterface<TestsResponse> *writer);
 
         Status GenerateFileTests(ServerContext *context,
                                  const FileRequest *request,
-                                 ServerWriter<TestsResponse> *writer) override;
+                                 ServerWriterInterface<TestsResponse> *writer);
 
         Status GenerateFunctionTests(ServerContext *context,
                                      const FunctionRequest *request,
-                                     ServerWriter<TestsResponse> *writer) override;
+                                     ServerWriterInterface<TestsResponse> *writer);
 
         Status GenerateClassTests(ServerContext *context,
                                      const ClassRequest *request,
-                                     ServerWriter<TestsResponse> *writer) override;
+                                     ServerWriterInterface<TestsResponse> *writer);
 
         Status GenerateFolderTests(ServerContext *context,
                                    const FolderRequest *request,
-                                   ServerWriter<TestsResponse> *writer) override;
+                                   ServerWriterInterface<TestsResponse> *writer);
 
         Status GenerateLineTests(ServerContext *context,
                                  const LineRequest *request,
-                                 ServerWriter<TestsResponse> *writer) override;
+                                 ServerWriterInterface<TestsResponse> *writer);
 
         Status GeneratePredicateTests(ServerContext *context,
                                       const PredicateRequest *request,
-                                      ServerWriter<TestsResponse> *writer) override;
+                                      ServerWriterInterface<TestsResponse> *writer);
 
         Status GenerateAssertionFailTests(ServerContext *context,
                                           const AssertionRequest *request,
-                                          ServerWriter<TestsResponse> *writer) override;
+                                          ServerWriterInterface<TestsResponse> *writer);
 
         Status CreateTestsCoverageAndResult(
             ServerContext *context,
             const CoverageAndResultsRequest *request,
-            ServerWriter<::testsgen::CoverageAndResultsResponse> *writer) override;
+            ServerWriterInterface<::testsgen::CoverageAndResultsResponse> *writer);
 
         Status GenerateProjectStubs(ServerContext *context,
                                     const ProjectRequest *request,
-                                    ServerWriter<StubsResponse> *writer) override;
+                                    ServerWriterInterface<StubsResponse> *writer);
 
         Status GetSourceCode(ServerContext *context,
                              const SourceInfo *request,
-                             SourceCode *response) override;
+                             SourceCode *response);
 
         Status ConfigureProject(ServerContext *context,
                                 const ProjectConfigRequest *request,
-                                ServerWriter<ProjectConfigResponse> *response) override;
+                                ServerWriterInterface<ProjectConfigResponse> *response);
 
         Status GetProjectTargets(ServerContext *context,
                                  const ProjectTargetsRequest *request,
-                                 ProjectTargetsResponse *response) override;
+                                 ProjectTargetsResponse *response);
 
         Status GetFileTargets(ServerContext *context,
                               const FileTargetsRequest *request,
-                              FileTargetsResponse *response) override;
+                              FileTargetsResponse *response);
 
 
         static Status ProcessBaseTestRequest(BaseTestGen &testGen, TestsWriter *testsWriter);
 
         static Status ProcessProjectStubsRequest(BaseTestGen *testGen, StubsWriter *stubsWriter);
 
+        /**
+         * Lets all open log channels finish, so their threads can be joined on shutdown.
+         */
+        void closeLogChannels();
+
+        /**
+         * Called by test generation requests once they hold the client lock. Tests use it
+         * to keep a generation running while other requests are checked.
+         */
+        std::function<void()> generationStartedHook;
+
         friend bool LogUtils::logChannelsWatcher(Server &server);
     private:
         std::mutex logChannelOperationsMutex;
@@ -214,12 +241,17 @@ public:
 
         std::unique_lock<RequestLockMutex> acquireLock(ProgressWriter *writer = nullptr);
 
+        static LineInfo findLineInfo(const fs::path &filePath,
+                                     unsigned line,
+                                     const std::shared_ptr<CompilationDatabase> &compilationDatabase,
+                                     const fs::path &compileCommandsJsonPath);
+
         static std::shared_ptr<LineInfo> getLineInfo(LineTestGen &lineTestGen);
 
         static Status failedToLoadCDbStatus(const CompilationDatabaseException &e);
 
         Status provideLoggingCallbacks(const std::string &callbackPrefix,
-                                       ServerWriter<LogEntry> *writer,
+                                       ServerWriterInterface<LogEntry> *writer,
                                        const std::string &logLevel,
                                        loguru::log_handler_t handler,
                                        std::map<std::string, std::atomic_bool> &channelStorage,
@@ -242,15 +274,66 @@ private:
     const static std::string logPrefix;
     const static std::string gtestLogPrefix;
 
+    const static size_t POLLING_THREADS_COUNT = 2;
+    const static size_t METADATA_WORKERS_COUNT = 2;
+    const static size_t CONTROL_WORKERS_COUNT = 2;
+    // running calls are cancelled if they don't finish in this time after shutdown
+    static constexpr std::chrono::seconds SHUTDOWN_TIMEOUT{ 5 };
+
     std::unique_ptr<grpc::Server> gRPCServer;
+    TestsGenService::AsyncService asyncService;
+    std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> completionQueues;
+    std::vector<std::thread> pollingThreads;
+    // heavy calls are run by a bounded number of workers, separately from polling threads,
+    // so short calls are answered while generation is in progress
+    std::unique_ptr<ThreadPool> generationPool;
+    std::unique_ptr<ThreadPool> metadataPool;
+    std::unique_ptr<ThreadPool> controlPool;
+    // log channels are held open while the client is alive, so each of them has a thread
+    std::mutex channelThreadsMutex;
+    std::vector<std::thread> channelThreads;
 
     std::atomic_bool logChannelsWatcherCancellationToken = false;
+    std::mutex logChannelsWatcherMutex;
+    std::condition_variable logChannelsWatcherCondition;
     std::future<bool> logChannelsWatcherTask;
 
+    void joinChannelThreads();
+
     static uint16_t getPort();
 
+    static size_t getWorkersCount();
+
+    void listenCalls(grpc::ServerCompletionQueue *completionQueue);
+
+    template <typename Service, typename Request, typename Response>
+    void listenUnaryCall(
+        void (Service::*requestMethod)(ServerContext *,
+                                       Request *,
+                                       grpc::ServerAsyncResponseWriter<Response> *,
+                                       grpc::CompletionQueue *,
+                                       grpc::ServerCompletionQueue *,
+                                       void *),
+        Status (TestsGenServiceImpl::*handler)(ServerContext *, const Request *, Response *),
+        const utbot::CallExecutor &executor,
+        grpc::ServerCompletionQueue *completionQueue);
+
+    template <typename Service, typename Request, typename Response>
+    void listenServerStreamingCall(
+        void (Service::*requestMethod)(ServerContext *,
+                                       Request *,
+                                       grpc::ServerAsyncWriter<Response> *,
+                                       grpc::CompletionQueue *,
+                                       grpc::ServerCompletionQueue *,
+                                       void *),
+        Status (TestsGenServiceImpl::*handler)(ServerContext *,
+                                               const Request *,
+                                               ServerWriterInterface<Response> *),
+        const utbot::CallExecutor &executor,
+        grpc::ServerCompletionQueue *completionQueue);
+
     struct WriterData {
-        ServerWriter<LogEntry> *writer;
+        ServerWriterInterface<LogEntry> *writer;
         std::mutex writerMutex;
         const std::string client;
     };
@@ -1,12 +1,14 @@
 #include "Synchronizer.h"
 
 #include "clang-utils/SourceToHeaderRewriter.h"
+#include "exceptions/CompilationDatabaseException.h"
 #include "exceptions/FileSystemException.h"
 #include "fetchers/Fetcher.h"
 #include "printers/CCJsonPrinter.h"
 #include "printers/SourceWrapperPrinter.h"
 #include "printers/StubsPrinter.h"
 #include "streams/stubs/StubsWriter.h"
+#include "testgens/FolderTestGen.h"
 #include "testgens/SnippetTestGen.h"
 #include "utils/TypeUtils.h"
 
@@ -65,12 +67,44 @@ bool Synchronizer::isProbablyOutdated(const fs::path &srcFilePath) const {
     return stubTimestamp <= srcTimestamp;
 }
 
-CollectionUtils::FileSet Synchronizer::getOutdatedSourcePaths() const {
-    return CollectionUtils::filterOut(getAllFiles(), [this](fs::path const &sourcePath) {
+CollectionUtils::FileSet
+Synchronizer::getOutdatedSourcePaths(const CollectionUtils::FileSet &sourcePaths) const {
+    return CollectionUtils::filterOut(sourcePaths, [this](fs::path const &sourcePath) {
         return !isProbablyOutdated(sourcePath);
     });
 }
 
+CollectionUtils::FileSet Synchronizer::getSourcesToSynchronize() const {
+    if (TypeUtils::isSameType<FolderTestGen>(*testGen)) {
+        // source paths of a folder request are already narrowed to the folder and its targets
+        return CollectionUtils::filterOut(testGen->sourcePaths, [this](const fs::path &sourcePath) {
+            return !CollectionUtils::contains(getAllFiles(), sourcePath);
+        });
+    }
+    if (testGen->isBatched() || !testGen->targetPath.has_value() ||
+        testGen->testingMethodsSourcePaths.empty()) {
+        return getAllFiles();
+    }
+    try {
+        std::optional<fs::path> target;
+        if (!testGen->hasAutoTarget()) {
+            target = testGen->getTargetPath();
+        }
+        auto result = CollectionUtils::filterOut(
+            testGen->buildDatabase->getLinkedSourcePaths(testGen->testingMethodsSourcePaths, target),
+            [this](const fs::path &sourcePath) {
+                return !CollectionUtils::contains(getAllFiles(), sourcePath);
+            });
+        LOG_S(DEBUG) << "Synchronizing " << result.size() << " of " << getAllFiles().size()
+                     << " sources linked into the targets of the request";
+        return result;
+    } catch (const CompilationDatabaseException &e) {
+        LOG_S(DEBUG) << "Couldn't find targets of the request, synchronizing all sources: "
+                     << e.what();
+        return getAllFiles();
+    }
+}
+
 bool Synchronizer::removeStubIfSourceAbsent(const StubOperator &stub) const {
     if (!fs::exists(stub.getSourceFilePath())) {
         try {
@@ -109,21 +143,24 @@ CollectionUtils::FileSet Synchronizer::dropHeaders(const CollectionUtils::FileSe
     });
 }
 
-void Synchronizer::synchronize(const types::TypesHandler &typesHandler) {
+void Synchronizer::synchronize(const types::TypesHandler &typesHandler, StubsWriter *stubsWriter) {
     if (TypeUtils::isSameType<SnippetTestGen>(*this->testGen)) {
         return;
     }
-    auto outdatedSourcePaths = getOutdatedSourcePaths();
+    auto sourcePaths = getSourcesToSynchronize();
+    auto outdatedSourcePaths = getOutdatedSourcePaths(sourcePaths);
     if (testGen->settingsContext.useStubs) {
         auto outdatedStubs = getStubSetFromSources(outdatedSourcePaths);
-        synchronizeStubs(outdatedStubs, typesHandler);
+        synchronizeStubs(outdatedStubs, sourcePaths, typesHandler, stubsWriter);
     }
-    synchronizeWrappers(outdatedSourcePaths);
+    synchronizeWrappers(outdatedSourcePaths, sourcePaths);
 }
 
 void Synchronizer::synchronizeStubs(StubSet &outdatedStubs,
-                                    const types::TypesHandler &typesHandler) {
-    StubSet allStubs = getStubSetFromSources(getAllFiles());
+                                    const CollectionUtils::FileSet &sourcePaths,
+                                    const types::TypesHandler &typesHandler,
+                                    StubsWriter *stubsWriter) {
+    StubSet allStubs = getStubSetFromSources(sourcePaths);
     auto stubDirPath = Paths::getStubsDirPath(testGen->projectContext);
     prepareDirectory(stubDirPath);
     auto filesInFolder = Paths::findFilesInFolder(stubDirPath);
@@ -160,22 +197,27 @@ void Synchronizer::synchronizeStubs(StubSet &outdatedStubs,
     SourceToHeaderRewriter(testGen->projectContext, testGen->compilationDatabase,
                            stubFetcher.getStructsToDeclare(), testGen->serverBuildDir);
 
+    size_t stubsCounter = 0;
     for (const StubOperator &outdatedStub : outdatedStubs) {
         fs::path stubPath = outdatedStub.getStubPath(testGen->projectContext);
         Tests const &methodDescription = stubFilesMap[stubPath];
+        Stubs stubFile;
         if (outdatedStub.isHeader()) {
-            std::string code = sourceToHeaderRewriter.generateStubHeader(outdatedStub.getSourceFilePath());
-            testGen->synchronizedStubs.emplace_back(stubPath, code);
+            std::string code = sourceToHeaderRewriter.generateStubHeader(outdatedStub.getSourceFilePath(), stubPath);
+            stubFile = Stubs(stubPath, code);
         } else {
             tests::Tests newStubFile = StubGen::mergeSourceFileIntoStub(
                 methodDescription, sourceFilesMap.at(outdatedStub.getSourceFilePath()));
             printer::StubsPrinter stubsPrinter(Paths::getSourceLanguage(stubPath));
-            Stubs stubFile =
-                stubsPrinter.genStubFile(newStubFile, typesHandler, testGen->projectContext);
-            testGen->synchronizedStubs.emplace_back(stubFile);
+            stubFile = stubsPrinter.genStubFile(newStubFile, typesHandler, testGen->projectContext);
+        }
+        // every stub is written and sent as soon as it is generated
+        StubsWriter::writeStubFileOnServer(stubFile);
+        if (stubsWriter != nullptr) {
+            stubsWriter->writeStub(stubFile, (100.0 * stubsCounter) / outdatedStubs.size());
         }
+        ++stubsCounter;
     }
-    StubsWriter::writeStubsFilesOnServer(testGen->synchronizedStubs, testGen->projectContext.testDirPath);
 }
 
 std::shared_ptr<CompilationDatabase>
@@ -188,9 +230,10 @@ Synchronizer::createStubsCompilationDatabase(StubSet &stubFiles,
     return CompilationUtils::getCompilationDatabase(ccJsonStubDirPath);
 }
 
-void Synchronizer::synchronizeWrappers(const CollectionUtils::FileSet &outdatedSourcePaths) const {
+void Synchronizer::synchronizeWrappers(const CollectionUtils::FileSet &outdatedSourcePaths,
+                                       const CollectionUtils::FileSet &sourcePaths) const {
     auto sourceFilesNeedToRegenerateWrappers = outdatedSourcePaths;
-    for (fs::path const &sourceFilePath : getAllFiles()) {
+    for (fs::path const &sourceFilePath : sourcePaths) {
         if (!CollectionUtils::contains(sourceFilesNeedToRegenerateWrappers, sourceFilePath)) {
             auto wrapperFilePath =
                 Paths::getWrapperFilePath(testGen->projectContext, sourceFilePath);
@@ -6,6 +6,8 @@
 #include "stubs/StubGen.h"
 #include "types/Types.h"
 
+class StubsWriter;
+
 class StubOperator {
 public:
     StubOperator(fs::path sourceFilePath, bool isHeader);
@@ -24,15 +26,25 @@ class Synchronizer {
     StubGen const *const stubGen;
     types::TypesHandler::SizeContext *sizeContext;
 
-    CollectionUtils::FileSet getOutdatedSourcePaths() const;
+    CollectionUtils::FileSet getOutdatedSourcePaths(const CollectionUtils::FileSet &sourcePaths) const;
+
+    /**
+     * Sources that may be linked together with the tested ones. Batched requests synchronize
+     * the whole project, others only the sources of the targets that are tried by Linker,
+     * the rest is left to project level requests.
+     */
+    CollectionUtils::FileSet getSourcesToSynchronize() const;
 
     bool isProbablyOutdated(const fs::path &srcFilePath) const;
 
     bool removeStubIfSourceAbsent(const StubOperator &stub) const;
 
     void synchronizeStubs(std::unordered_set<StubOperator, HashUtils::StubHash> &outdatedStubs,
-                          const types::TypesHandler &typesHandler);
-    void synchronizeWrappers(const CollectionUtils::FileSet &outdatedSourcePaths) const;
+                          const CollectionUtils::FileSet &sourcePaths,
+                          const types::TypesHandler &typesHandler,
+                          StubsWriter *stubsWriter);
+    void synchronizeWrappers(const CollectionUtils::FileSet &outdatedSourcePaths,
+                             const CollectionUtils::FileSet &sourcePaths) const;
 
     std::shared_ptr<CompilationDatabase>
     createStubsCompilationDatabase(
@@ -51,7 +63,10 @@ public:
 
     Synchronizer(BaseTestGen *testGen, StubGen const *stubGen, types::TypesHandler::SizeContext *sizeContext);
 
-    void synchronize(const types::TypesHandler &typesHandler);
+    /**
+     * @param stubsWriter if set, receives every synchronized stub as soon as it is written.
+     */
+    void synchronize(const types::TypesHandler &typesHandler, StubsWriter *stubsWriter = nullptr);
 
     const CollectionUtils::FileSet &getAllFiles() const;
 };
@@ -29,6 +29,29 @@ Tests::MethodDescription::MethodDescription()
                 { Tests::ERROR_SUITE_NAME, std::string() } } {
 }
 
+std::string Tests::SkipRecord::toCommentBlock() const {
+    switch (reason) {
+    case Reason::UNSUPPORTED_RETURN_TYPE:
+        return StringUtils::stringFormat(
+            "Function '%s' was skipped, as return type '%s' is not fully supported: %s",
+            methodName, subject, info);
+    case Reason::UNSUPPORTED_PARAMETER:
+        return StringUtils::stringFormat(
+            "Function '%s' was skipped, as parameter '%s' is not fully supported: %s",
+            methodName, subject, info);
+    case Reason::STATIC_FUNCTION:
+        return StringUtils::stringFormat(
+            "Function '%s' was skipped, as option \"Generate For Static Functions\"is disabled",
+            methodName);
+    case Reason::INLINE_FUNCTION:
+        return StringUtils::stringFormat(
+            "Function '%s' was skipped, as inline function without static or extern "
+            "modifier is not supported by now",
+            methodName);
+    }
+    throw UnImplementedException("Unknown skip reason");
+}
+
 static std::string makeDecimalConstant(std::string value, const std::string &typeName) {
     if (typeName == "long") {
         if (value == INT64_MIN_STRING) {
@@ -617,7 +640,7 @@ types::Type KTestObjectParser::traverseLazyInStruct(std::vector<bool> &visited,
     std::string message;
     switch (typesHandler.getTypeKind(curVarType)) {
         case TypeKind::STRUCT: {
-            types::StructInfo structInfo = typesHandler.getStructInfo(curVarType);
+            const types::StructInfo &structInfo = typesHandler.getStructInfo(curVarType);
             size_t indField = findFieldIndex(structInfo, offset);
             const types::Field &next = structInfo.fields[indField];
             return traverseLazyInStruct(visited, next.type, offset - next.offset, testCase,
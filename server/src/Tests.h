@@ -524,6 +524,27 @@ namespace tests {
 
         using MethodsMap = tsl::ordered_map<std::string, MethodDescription>;
 
+        /**
+         * Function which was skipped by FeaturesFilter. Records are rendered into comment
+         * blocks only when the test file is printed.
+         */
+        struct SkipRecord {
+            enum class Reason {
+                UNSUPPORTED_RETURN_TYPE,
+                UNSUPPORTED_PARAMETER,
+                STATIC_FUNCTION,
+                INLINE_FUNCTION
+            };
+
+            Reason reason;
+            std::string methodName;
+            // return type name or parameter name, empty for other reasons
+            std::string subject;
+            std::string info;
+
+            [[nodiscard]] std::string toCommentBlock() const;
+        };
+
         static const std::string DEFAULT_SUITE_NAME;
         static const std::string ERROR_SUITE_NAME;
         static const MethodParam &getStdinMethodParam();
@@ -541,6 +562,7 @@ namespace tests {
         MethodsMap methods; // method's name -> description
         std::string code;       // contains final code of test file
         std::string headerCode; // contains code of header
+        std::vector<SkipRecord> skipRecords{};
         std::vector<std::string> commentBlocks{};
         std::string stubs; // language-independent stubs definitions
 
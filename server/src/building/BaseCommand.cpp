@@ -19,55 +19,103 @@
 namespace utbot {
     BaseCommand::BaseCommand(std::list<std::string> commandLine, fs::path directory, bool shouldChangeDirectory)
         : commandLine(std::move(commandLine)), directory(std::move(directory)), shouldChangeDirectory{shouldChangeDirectory} {
-        initOptimizationLevel();
+        initOptionsIndex();
     }
     BaseCommand::BaseCommand(std::vector<std::string> commandLine, fs::path directory, bool shouldChangeDirectory)
-        : commandLine(commandLine.begin(), commandLine.end()), directory(std::move(directory)), shouldChangeDirectory{shouldChangeDirectory} {
-        initOptimizationLevel();
+        : commandLine(std::make_move_iterator(commandLine.begin()), std::make_move_iterator(commandLine.end())),
+          directory(std::move(directory)), shouldChangeDirectory{shouldChangeDirectory} {
+        initOptionsIndex();
     }
 
     BaseCommand::BaseCommand(BaseCommand const &other)
         : directory(other.directory), commandLine(other.commandLine),
           environmentVariables(other.environmentVariables), shouldChangeDirectory(other.shouldChangeDirectory) {
-        if (other.optimizationLevel.has_value()) {
-            optimizationLevel =
-                std::next(commandLine.begin(),
-                          std::distance<const_iterator>(other.commandLine.begin(),
-                                                        other.optimizationLevel.value()));
-        }
+        initOptionsIndex();
     }
     BaseCommand::BaseCommand(BaseCommand &&other) noexcept
         : directory(std::move(other.directory)), commandLine(std::move(other.commandLine)),
           environmentVariables(std::move(other.environmentVariables)),
-          optimizationLevel(other.optimizationLevel), shouldChangeDirectory(other.shouldChangeDirectory) {
+          options(std::move(other.options)), shouldChangeDirectory(other.shouldChangeDirectory) {
+    }
+
+    namespace {
+        const std::string OUTPUT_FLAG = "-o";
+    }
+
+    void BaseCommand::initOptionsIndex() {
+        options = {};
+        indexArguments(commandLine.begin(), commandLine.end());
+    }
+
+    void BaseCommand::refreshOptionsIndex() {
+        if (options.outdated) {
+            initOptionsIndex();
+        }
+    }
+
+    void BaseCommand::indexArgument(iterator it) {
+        const std::string &argument = *it;
+        if (options.outdated || argument.size() < 2 || argument[0] != '-') {
+            return;
+        }
+        switch (argument[1]) {
+        case 'o':
+            if (argument == OUTPUT_FLAG && !options.output.has_value()) {
+                options.output = it;
+            }
+            break;
+        case 'O':
+            if (!options.optimizationLevel.has_value()) {
+                options.optimizationLevel = it;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void BaseCommand::unindexArgument(iterator it) {
+        for (auto *option : { &options.output, &options.optimizationLevel }) {
+            if (option->has_value() && option->value() == it) {
+                option->reset();
+            }
+        }
     }
 
-    void BaseCommand::initOptimizationLevel() {
-        auto it = findOptimizationLevelFlag();
-        if (it != commandLine.end()) {
-            optimizationLevel = it;
+    void BaseCommand::indexArguments(iterator first, iterator last) {
+        for (auto it = first; it != last; ++it) {
+            indexArgument(it);
         }
     }
+
+    BaseCommand::iterator BaseCommand::eraseArgument(iterator it) {
+        unindexArgument(it);
+        return commandLine.erase(it);
+    }
+
     BaseCommand::iterator BaseCommand::findOutput() {
-        auto it = std::find(commandLine.begin(), commandLine.end(), "-o");
-        if (it != commandLine.end()) {
-            return std::next(it, 1);
+        refreshOptionsIndex();
+        if (options.output.has_value()) {
+            return std::next(options.output.value(), 1);
         }
-        return it;
+        return commandLine.end();
     }
 
     BaseCommand::iterator BaseCommand::findOptimizationLevelFlag() {
-        return std::find_if(commandLine.begin(), commandLine.end(), [](std::string const &flag) {
-            return StringUtils::startsWith(flag, "-O");
-        });
+        refreshOptionsIndex();
+        return options.optimizationLevel.value_or(commandLine.end());
     }
 
     BaseCommand::iterator BaseCommand::addFlagToBegin(std::string flag) {
-        return commandLine.insert(std::next(commandLine.begin()), std::move(flag));
+        auto it = commandLine.insert(std::next(commandLine.begin()), std::move(flag));
+        indexArgument(it);
+        return it;
     }
 
     BaseCommand::iterator BaseCommand::addFlagToEnd(std::string flag) {
-        return commandLine.insert(std::end(commandLine), std::move(flag));
+        auto it = commandLine.insert(std::end(commandLine), std::move(flag));
+        indexArgument(it);
+        return it;
     }
 
     void BaseCommand::addEnvironmentVariable(std::string name, std::string value) {
@@ -86,10 +134,6 @@ namespace utbot {
         return environment + " " + command;
     }
 
-    std::list<std::string> &BaseCommand::getCommandLine() {
-        return commandLine;
-    }
-
     const std::list<std::string> &BaseCommand::getCommandLine() const {
         return commandLine;
     }
@@ -99,13 +143,32 @@ namespace utbot {
     }
 
     bool BaseCommand::replace(const fs::path &from, const fs::path &to) {
-        return CollectionUtils::replace(commandLine, from, to);
+        bool replaced = CollectionUtils::replace(commandLine, from, to);
+        if (replaced) {
+            options.outdated = true;
+        }
+        return replaced;
     }
     bool BaseCommand::erase(std::string const &arg) {
-        return CollectionUtils::erase(commandLine, arg);
+        return erase_if([&arg](std::string const &argument) { return argument == arg; }) > 0;
     }
     size_t BaseCommand::erase_if(std::function<bool(std::string)> f) {
-        return CollectionUtils::erase_if(commandLine, f);
+        size_t erased = 0;
+        for (auto it = commandLine.begin(); it != commandLine.end();) {
+            if (f(*it)) {
+                it = eraseArgument(it);
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+        return erased;
+    }
+    void BaseCommand::transformArguments(const std::function<void(std::string &)> &f) {
+        for (std::string &argument : commandLine) {
+            f(argument);
+        }
+        options.outdated = true;
     }
     std::string BaseCommand::toStringWithChangingDirectory() const {
         return toStringWithChangingDirectoryToNew(directory);
@@ -121,10 +184,11 @@ namespace utbot {
     }
 
     void BaseCommand::setOptimizationLevel(const std::string &flag) {
-        if (optimizationLevel.has_value()) {
-            *(optimizationLevel.value()) = flag;
+        refreshOptionsIndex();
+        if (options.optimizationLevel.has_value()) {
+            *(options.optimizationLevel.value()) = flag;
         } else {
-            optimizationLevel = addFlagToBegin(flag);
+            options.optimizationLevel = addFlagToBegin(flag);
         }
     }
 }
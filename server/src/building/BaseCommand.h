@@ -23,9 +23,33 @@ namespace utbot {
         using iterator = decltype(commandLine)::iterator;
         using const_iterator = decltype(commandLine)::const_iterator;
 
-        std::optional<iterator> optimizationLevel;
+        /**
+         * Positions of the options that are looked up and rewritten for every command.
+         * Iterators of std::list are not invalidated by insertions and erasures of other
+         * arguments, so the index is built in one pass and then kept up to date by the
+         * methods which add or remove arguments. Arguments changed through transformArguments()
+         * or replace() may become or stop being options, so the index is then rebuilt on
+         * the next lookup.
+         */
+        struct OptionsIndex {
+            std::optional<iterator> output;
+            std::optional<iterator> optimizationLevel;
+            bool outdated = false;
+        };
 
-        void initOptimizationLevel();
+        OptionsIndex options;
+
+        void initOptionsIndex();
+
+        void refreshOptionsIndex();
+
+        void indexArgument(iterator it);
+
+        void unindexArgument(iterator it);
+
+        void indexArguments(iterator first, iterator last);
+
+        iterator eraseArgument(iterator it);
 
         [[nodiscard]] iterator findOutput();
 
@@ -42,8 +66,6 @@ namespace utbot {
 
         BaseCommand(BaseCommand &&other) noexcept;
 
-        [[nodiscard]] std::list<std::string> &getCommandLine();
-
         [[nodiscard]] const std::list<std::string> &getCommandLine() const;
 
         [[nodiscard]] const fs::path &getDirectory() const;
@@ -56,20 +78,27 @@ namespace utbot {
 
         template<typename ContainerT = std::initializer_list<std::string>, typename IteratorT = typename ContainerT::iterator>
         iterator addFlagsBeforeIterator(ContainerT&& flags, IteratorT&& it) {
-            return commandLine.insert(it, std::begin(flags), std::end(flags));
+            iterator position = it;
+            iterator first = commandLine.insert(position, std::begin(flags), std::end(flags));
+            indexArguments(first, position);
+            return first;
         }
 
         template<typename ContainerT = std::initializer_list<std::string>>
         iterator addFlagsToBegin(ContainerT&& flags) {
-            return commandLine.insert(std::next(commandLine.begin()), std::begin(flags),
-                                      std::end(flags));
+            iterator position = std::next(commandLine.begin());
+            iterator first = commandLine.insert(position, std::begin(flags), std::end(flags));
+            indexArguments(first, position);
+            return first;
         }
 
         iterator addFlagToEnd(std::string flags);
 
         template<typename ContainerT = std::initializer_list<std::string>>
         iterator addFlagsToEnd(ContainerT&& flags) {
-            return commandLine.insert(std::end(commandLine), std::begin(flags), std::end(flags));
+            iterator first = commandLine.insert(std::end(commandLine), std::begin(flags), std::end(flags));
+            indexArguments(first, commandLine.end());
+            return first;
         }
 
         void addEnvironmentVariable(std::string name, std::string value);
@@ -88,6 +117,8 @@ namespace utbot {
 
         size_t erase_if(std::function<bool(std::string)> f);
 
+        void transformArguments(const std::function<void(std::string &)> &f);
+
         void setOptimizationLevel(const std::string &flag);
     };
 }
@@ -293,11 +293,11 @@ void BuildDatabase::addLibrariesForCommand(utbot::BaseCommand &command,
             }
         }
     }
-    for (auto &argument : command.getCommandLine()) {
+    command.transformArguments([&argumentToFile](std::string &argument) {
         if (CollectionUtils::containsKey(argumentToFile, argument)) {
             argument = argumentToFile[argument];
         }
-    }
+    });
 }
 
 void BuildDatabase::filterInstalledFiles() {
@@ -385,6 +385,27 @@ fs::path BuildDatabase::getObjectFile(const fs::path &sourceFile) const {
     return objectInfo->getOutputFile();
 }
 
+CollectionUtils::FileSet
+BuildDatabase::getLinkedSourcePaths(const CollectionUtils::FileSet &sourcePaths,
+                                    const std::optional<fs::path> &target) const {
+    CollectionUtils::FileSet targets;
+    if (target.has_value()) {
+        targets.insert(target.value());
+    } else {
+        for (fs::path const &sourcePath : sourcePaths) {
+            fs::path objectFile = getClientCompilationUnitInfo(sourcePath)->getOutputFile();
+            CollectionUtils::extend(targets, autoTargetListForFile(sourcePath, objectFile));
+        }
+    }
+    CollectionUtils::FileSet result;
+    for (fs::path const &linkedTarget : targets) {
+        for (fs::path const &objectFile : getArchiveObjectFiles(linkedTarget)) {
+            result.insert(getClientCompilationUnitInfo(objectFile)->getSourcePath());
+        }
+    }
+    return result;
+}
+
 CollectionUtils::FileSet BuildDatabase::getArchiveObjectFiles(const fs::path &archive) const {
     if (Paths::isGtest(archive)) {
         return {};
@@ -119,6 +119,18 @@ public:
      */
     [[nodiscard]] CollectionUtils::FileSet getArchiveObjectFiles(const fs::path &archive) const;
 
+    /**
+     * @brief Returns sources of all object files linked into the targets of the source files
+     *
+     * @param sourcePaths Source files whose targets are used
+     * @param target Target to use instead of the targets the sources are linked into by default
+     * @return Set of paths to source files.
+     * @throws CompilationDatabaseException if files are wrong
+     */
+    [[nodiscard]] CollectionUtils::FileSet
+    getLinkedSourcePaths(const CollectionUtils::FileSet &sourcePaths,
+                         const std::optional<fs::path> &target = std::nullopt) const;
+
     /**
      * @brief Returns compile command information for current source file or object file
      *
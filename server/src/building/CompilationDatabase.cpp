@@ -38,6 +38,11 @@ const CollectionUtils::FileSet &CompilationDatabase::getAllFiles() const {
     return allFiles;
 }
 
+CollectionUtils::FileSet CompilationDatabase::getFilesUnder(const fs::path &directory) const {
+    std::call_once(allFilesTrieFlag, [this]() { allFilesTrie.emplace(allFiles); });
+    return allFilesTrie->getPathsUnder(directory);
+}
+
 const fs::path &CompilationDatabase::getBuildCompilerPath() const {
     return buildCompilerPath;
 }
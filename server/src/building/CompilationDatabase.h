@@ -2,9 +2,13 @@
 #define UNITTESTBOT_COMPILATIONDATABASE_H
 
 #include "utils/CollectionUtils.h"
+#include "utils/PathTrie.h"
 
 #include <clang/Tooling/CompilationDatabase.h>
 
+#include <mutex>
+#include <optional>
+
 class CompilationDatabase {
 public:
     explicit CompilationDatabase(
@@ -15,11 +19,18 @@ public:
 
     const clang::tooling::CompilationDatabase &getClangCompilationDatabase() const;
     const CollectionUtils::FileSet &getAllFiles() const;
+    /**
+     * Files of the database inside the directory at any depth. Index of the files is built on
+     * the first call.
+     */
+    CollectionUtils::FileSet getFilesUnder(const fs::path &directory) const;
     const fs::path &getBuildCompilerPath() const;
     const std::optional<fs::path>& getResourceDir() const;
 private:
     std::unique_ptr<clang::tooling::CompilationDatabase> clangCompilationDatabase;
     CollectionUtils::FileSet allFiles;
+    mutable std::once_flag allFilesTrieFlag;
+    mutable std::optional<PathTrie> allFilesTrie;
     fs::path buildCompilerPath;
     std::optional<fs::path> resourceDir;
 
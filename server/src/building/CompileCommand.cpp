@@ -77,7 +77,7 @@ namespace utbot {
         std::swap(a.directory, b.directory);
         std::swap(a.commandLine, b.commandLine);
         std::swap(a.environmentVariables, b.environmentVariables);
-        std::swap(a.optimizationLevel, b.optimizationLevel);
+        std::swap(a.options, b.options);
 
         std::swap(a.sourcePath, b.sourcePath);
         std::swap(a.compiler, b.compiler);
@@ -115,7 +115,7 @@ namespace utbot {
     void CompileCommand::removeCompilerFlagsAndOptions(
         const std::unordered_set<std::string> &switchesToRemove) {
         size_t erased =
-            CollectionUtils::erase_if(commandLine, [&switchesToRemove](std::string const &arg) {
+            erase_if([&switchesToRemove](std::string const &arg) {
                 size_t pos = arg.find('=');
                 const std::string &toFind = pos == std::string::npos ? arg : arg.substr(0, pos);
                 return CollectionUtils::contains(switchesToRemove, toFind);
@@ -124,12 +124,12 @@ namespace utbot {
     }
 
     void CompileCommand::removeIncludeFlags() {
-        CollectionUtils::erase_if(commandLine, [](const std::string &arg) {
+        erase_if([](const std::string &arg) {
             return StringUtils::startsWith(arg, "-I");
         });
     }
     void CompileCommand::removeWerror() {
-        CollectionUtils::erase_if(commandLine, [](const std::string &arg) {
+        erase_if([](const std::string &arg) {
             return StringUtils::startsWith(arg, "-Werror");
         });
     }
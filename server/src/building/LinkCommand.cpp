@@ -72,7 +72,7 @@ namespace utbot {
         std::swap(a.directory, b.directory);
         std::swap(a.commandLine, b.commandLine);
         std::swap(a.environmentVariables, b.environmentVariables);
-        std::swap(a.optimizationLevel, b.optimizationLevel);
+        std::swap(a.options, b.options);
 
         std::swap(a.linker, b.linker);
         std::swap(a.output, b.output);
@@ -229,8 +229,27 @@ void Linker::addToGenerated(const CollectionUtils::FileSet &objectFiles, const f
     }
 }
 
+void Linker::linkForSnippet(const fs::path &sourceFilePath) {
+    ExecUtils::throwIfCancelled();
+
+    // snippet is a single translation unit included into its klee file, so the klee bitcode
+    // is already the whole module: siblings, stubs and makefiles are not needed, and snippet
+    // tests are returned to the client instead of being run
+    auto compilationUnitInfo = testGen.buildDatabase->getClientCompilationUnitInfo(sourceFilePath);
+    fs::path targetBitcode = compilationUnitInfo->kleeFilesInfo->getKleeBitcodeFile();
+    bool success = irParser.parseModule(targetBitcode, testGen.tests);
+    if (!success) {
+        std::string message = StringUtils::stringFormat("Couldn't parse module: %s", targetBitcode);
+        throw CompilationDatabaseException(message);
+    }
+
+    addToGenerated({ compilationUnitInfo->getOutputFile() }, targetBitcode);
+}
+
 void Linker::prepareArtifacts() {
-    if (isForOneFile()) {
+    if (isSameType<SnippetTestGen>(testGen)) {
+        linkForSnippet(getSourceFilePath());
+    } else if (isForOneFile()) {
         fs::path sourceFilePath = getSourceFilePath();
         linkForOneFile(sourceFilePath);
     } else {
@@ -313,6 +332,10 @@ std::vector<tests::TestMethod> Linker::getTestMethods() {
     return testMethods;
 }
 
+const CollectionUtils::FileSet &Linker::getStubbedSources() const {
+    return stubbedSources;
+}
+
 Linker::Linker(BaseTestGen &testGen,
                StubGen stubGen,
                std::shared_ptr<LineInfo> lineInfo,
@@ -409,6 +432,10 @@ Result<Linker::LinkResult> Linker::link(const CollectionUtils::MapFileTo<fs::pat
             testMakefilesPrinter.GetMakefiles(sourcePath).write();
         }
     }
+    CollectionUtils::extend(stubbedSources, stubSources);
+    for (const fs::path &stubPath : Synchronizer::dropHeaders(stubsSet)) {
+        stubbedSources.insert(Paths::stubPathToSourcePath(testGen.projectContext, stubPath));
+    }
     return LinkResult{ targetBitcode, stubsSet, presentedFiles };
 };
 
@@ -31,6 +31,12 @@ public:
 
     std::vector<tests::TestMethod> getTestMethods();
 
+    /**
+     * Sources replaced with stubs in the linked bitcode: the stubbed siblings of the tested
+     * files and the sources defining the symbols that the bitcode references as undefined.
+     */
+    [[nodiscard]] const CollectionUtils::FileSet &getStubbedSources() const;
+
     BuildResult
     addLinkTargetRecursively(const fs::path &fileToBuild,
                              printer::DefaultMakefilePrinter &bitcodeLinkMakefilePrinter,
@@ -55,6 +61,7 @@ private:
     CollectionUtils::FileSet testedFiles;
     CollectionUtils::MapFileTo<fs::path> bitcodeFileName;
     CollectionUtils::FileSet brokenLinkFiles;
+    CollectionUtils::FileSet stubbedSources;
 
     IRParser irParser;
 
@@ -70,6 +77,7 @@ private:
 
     Result<Linker::LinkResult> linkWholeTarget(const fs::path &target);
     void linkForOneFile(const fs::path &sourceFilePath);
+    void linkForSnippet(const fs::path &sourceFilePath);
     void linkForProject();
     Result<Linker::LinkResult> link(const CollectionUtils::MapFileTo<fs::path> &bitcodeFiles,
                                     const fs::path &root,
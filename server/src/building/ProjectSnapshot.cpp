@@ -0,0 +1,116 @@
+#include "ProjectSnapshot.h"
+
+#include "Paths.h"
+#include "exceptions/CompilationDatabaseException.h"
+#include "utils/CompilationUtils.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/LRUCache.h"
+#include "utils/StringUtils.h"
+
+#include "loguru.h"
+
+#include <mutex>
+
+namespace {
+    using FileSystemUtils::FileStamp;
+
+    struct CachedSnapshot {
+        FileStamp compileCommandsStamp;
+        FileStamp linkCommandsStamp;
+        std::shared_ptr<const ProjectSnapshot> snapshot;
+    };
+
+    // snapshots hold whole build databases, so only a few recently used projects are kept
+    const size_t MAX_CACHED_SNAPSHOTS = 8;
+
+    std::mutex cacheMutex;
+    LRUCache<std::string, CachedSnapshot> cachedSnapshots(MAX_CACHED_SNAPSHOTS);
+
+    std::pair<FileStamp, FileStamp> getCommandsStamps(const fs::path &compileCommandsJsonPath) {
+        auto compileCommandsStamp =
+            FileSystemUtils::getFileStamp(compileCommandsJsonPath / "compile_commands.json");
+        auto linkCommandsStamp =
+            FileSystemUtils::getFileStamp(compileCommandsJsonPath / "link_commands.json");
+        if (!compileCommandsStamp.has_value() || !linkCommandsStamp.has_value()) {
+            throw CompilationDatabaseException(
+                "Couldn't open link_commands.json or compile_commands.json files");
+        }
+        return { compileCommandsStamp.value(), linkCommandsStamp.value() };
+    }
+
+    // build database depends on the whole context, not only on the commands
+    std::string getCacheKey(const fs::path &compileCommandsJsonPath,
+                            const utbot::ProjectContext &projectContext) {
+        return StringUtils::joinWith(
+            std::vector<std::string>{ compileCommandsJsonPath.string(), projectContext.projectName,
+                                      projectContext.projectPath.string(),
+                                      projectContext.testDirPath.string(),
+                                      projectContext.buildDirRelativePath.string() },
+            "\n");
+    }
+
+    std::shared_ptr<const ProjectSnapshot> findCached(const std::string &key,
+                                                      bool anyStamp,
+                                                      const FileStamp &compileCommandsStamp,
+                                                      const FileStamp &linkCommandsStamp) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        const CachedSnapshot *cached = cachedSnapshots.get(key);
+        if (cached == nullptr ||
+            (!anyStamp && (cached->compileCommandsStamp != compileCommandsStamp ||
+                           cached->linkCommandsStamp != linkCommandsStamp))) {
+            return nullptr;
+        }
+        return cached->snapshot;
+    }
+
+    void storeCached(const std::string &key, CachedSnapshot cachedSnapshot) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        cachedSnapshots.put(key, std::move(cachedSnapshot));
+    }
+}
+
+ProjectSnapshot::ProjectSnapshot(fs::path compileCommandsJsonPath,
+                                 std::shared_ptr<const BuildDatabase> buildDatabase,
+                                 std::shared_ptr<CompilationDatabase> compilationDatabase)
+    : compileCommandsJsonPath(std::move(compileCommandsJsonPath)),
+      buildDatabase(std::move(buildDatabase)),
+      compilationDatabase(std::move(compilationDatabase)) {
+}
+
+std::shared_ptr<const ProjectSnapshot>
+ProjectSnapshot::get(const utbot::ProjectContext &projectContext) {
+    fs::path compileCommandsJsonPath =
+        CompilationUtils::substituteRemotePathToCompileCommandsJsonPath(
+            projectContext.projectPath, projectContext.buildDirRelativePath);
+    auto [compileCommandsStamp, linkCommandsStamp] = getCommandsStamps(compileCommandsJsonPath);
+    std::string key = getCacheKey(compileCommandsJsonPath, projectContext);
+    if (auto snapshot = findCached(key, false, compileCommandsStamp, linkCommandsStamp)) {
+        return snapshot;
+    }
+    // building is done without the lock, concurrent builds of one snapshot are equivalent
+    LOG_S(DEBUG) << "Building project snapshot for " << compileCommandsJsonPath;
+    std::shared_ptr<const ProjectSnapshot> snapshot;
+    try {
+        auto buildDatabase = std::make_shared<const BuildDatabase>(
+            compileCommandsJsonPath, Paths::getUtbotBuildDir(projectContext), projectContext);
+        auto compilationDatabase =
+            CompilationUtils::getCompilationDatabase(compileCommandsJsonPath);
+        snapshot.reset(new ProjectSnapshot(compileCommandsJsonPath, std::move(buildDatabase),
+                                           std::move(compilationDatabase)));
+    } catch (const std::exception &e) {
+        // commands may be rewritten by a concurrent configuration, the last snapshot is still valid
+        if (auto previous = findCached(key, true, compileCommandsStamp, linkCommandsStamp)) {
+            LOG_S(WARNING) << "Couldn't load commands, previous project snapshot is used: "
+                           << e.what();
+            return previous;
+        }
+        throw CompilationDatabaseException(e.what());
+    }
+    if (getCommandsStamps(compileCommandsJsonPath) !=
+        std::make_pair(compileCommandsStamp, linkCommandsStamp)) {
+        // commands were changed while they were read, so the snapshot isn't reused
+        return snapshot;
+    }
+    storeCached(key, { compileCommandsStamp, linkCommandsStamp, snapshot });
+    return snapshot;
+}
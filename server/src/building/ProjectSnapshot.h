@@ -0,0 +1,41 @@
+#ifndef UNITTESTBOT_PROJECTSNAPSHOT_H
+#define UNITTESTBOT_PROJECTSNAPSHOT_H
+
+#include "ProjectContext.h"
+#include "building/BuildDatabase.h"
+#include "building/CompilationDatabase.h"
+
+#include "utils/path/FileSystemPath.h"
+#include <memory>
+
+/**
+ * Immutable project model for read-only requests. Snapshots are shared between requests and
+ * are rebuilt only when compile or link commands of the project change, so read-only requests
+ * don't take the per-client lock which test generation holds. Snapshots are keyed by the whole
+ * project context and only a few recently used ones are kept.
+ */
+class ProjectSnapshot {
+public:
+    /**
+     * Returns snapshot of the project, building it if the commands have changed since
+     * the last call. If the commands can't be read, for example while a configuration rewrites
+     * them, the previous snapshot is returned.
+     * @throws CompilationDatabaseException if the commands couldn't be loaded
+     */
+    static std::shared_ptr<const ProjectSnapshot> get(const utbot::ProjectContext &projectContext);
+
+    ProjectSnapshot(const ProjectSnapshot &) = delete;
+    ProjectSnapshot &operator=(const ProjectSnapshot &) = delete;
+
+    const fs::path compileCommandsJsonPath;
+    const std::shared_ptr<const BuildDatabase> buildDatabase;
+    const std::shared_ptr<CompilationDatabase> compilationDatabase;
+
+private:
+    ProjectSnapshot(fs::path compileCommandsJsonPath,
+                    std::shared_ptr<const BuildDatabase> buildDatabase,
+                    std::shared_ptr<CompilationDatabase> compilationDatabase);
+};
+
+
+#endif // UNITTESTBOT_PROJECTSNAPSHOT_H
@@ -1,17 +1,28 @@
 #include "UserProjectConfiguration.h"
 
 #include "Paths.h"
+#include "building/CompileCommand.h"
+#include "building/LinkCommand.h"
 #include "environment/EnvironmentPaths.h"
 #include "tasks/ShellExecTask.h"
+#include "utils/CollectionUtils.h"
 #include "utils/Copyright.h"
 #include "utils/ExecUtils.h"
 #include "utils/FileSystemUtils.h"
+#include "utils/HashUtils.h"
+#include "utils/JsonUtils.h"
 #include "utils/LogUtils.h"
 #include "utils/MakefileUtils.h"
 #include "utils/StringUtils.h"
 
 #include "loguru.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <unordered_map>
+
 Status UserProjectConfiguration::CheckProjectConfiguration(const fs::path &buildDirPath,
                                                            ProjectConfigWriter const &writer) {
     if (!fs::exists(buildDirPath)) {
@@ -46,21 +57,31 @@ static const std::vector<std::string> CMAKE_MANDATORY_OPTIONS = {
     "-DCMAKE_CXX_USE_RESPONSE_FILE_FOR_LIBRARIES=OFF",
 };
 
+std::vector<std::string>
+UserProjectConfiguration::getCmakeOptionsWithMandatory(const std::vector<std::string> &cmakeOptions) {
+    std::vector<std::string> cmakeOptionsWithMandatory = CMAKE_MANDATORY_OPTIONS;
+    for (const std::string &op : cmakeOptions) {
+        if (op.find("_USE_RESPONSE_FILE_FOR_") == std::string::npos) {
+            cmakeOptionsWithMandatory.emplace_back(op);
+        }
+    }
+    cmakeOptionsWithMandatory.emplace_back("..");
+    return cmakeOptionsWithMandatory;
+}
+
 Status
 UserProjectConfiguration::RunProjectConfigurationCommands(const fs::path &buildDirPath,
                                                           const utbot::ProjectContext &projectContext,
                                                           std::vector<std::string> cmakeOptions,
-                                                          ProjectConfigWriter const &writer) {
+                                                          ProjectConfigWriter const &writer,
+                                                          bool incremental) {
     try {
         fs::path bearShPath = createBearShScript(buildDirPath);
 
-        std::vector<std::string> cmakeOptionsWithMandatory = CMAKE_MANDATORY_OPTIONS;
-        for (const std::string &op : cmakeOptions) {
-            if (op.find("_USE_RESPONSE_FILE_FOR_") == std::string::npos) {
-                cmakeOptionsWithMandatory.emplace_back(op);
-            }
-        }
-        cmakeOptionsWithMandatory.emplace_back("..");
+        std::vector<std::string> cmakeOptionsWithMandatory = getCmakeOptionsWithMandatory(cmakeOptions);
+        std::string inputsHash = getConfigurationInputsHash(projectContext.projectPath, buildDirPath,
+                                                            cmakeOptionsWithMandatory);
+        incremental = incremental && canCaptureIncrementally(buildDirPath, inputsHash);
 
         ShellExecTask::ExecutionParameters cmakeParams(Paths::getCMake(), cmakeOptionsWithMandatory);
         ShellExecTask::ExecutionParameters bearMakeParams(Paths::getBear(),
@@ -68,19 +89,34 @@ UserProjectConfiguration::RunProjectConfigurationCommands(const fs::path &buildD
 
 
         fs::path cmakeListsPath = getCmakeListsPath(buildDirPath);
-        if (fs::exists(cmakeListsPath)) {
-            LOG_S(INFO) << "Configure cmake project";
-            RunProjectConfigurationCommand(buildDirPath, cmakeParams, projectContext, writer);
-        } else {
+        if (!fs::exists(cmakeListsPath)) {
             LOG_S(INFO) << "CMakeLists.txt not found in root project directory: " << cmakeListsPath
                         << ". Skipping cmake step.";
+        } else if (incremental) {
+            LOG_S(INFO) << "CMake inputs are not changed. Skipping cmake step.";
+        } else {
+            LOG_S(INFO) << "Configure cmake project";
+            RunProjectConfigurationCommand(buildDirPath, cmakeParams, projectContext, writer);
+        }
+        fs::remove(getConfigurationStatePath(buildDirPath));
+        nlohmann::json previousCompileCommands, previousLinkCommands;
+        if (incremental) {
+            // bear overwrites the files with commands of the rebuilt targets only
+            previousCompileCommands = JsonUtils::getJsonFromFile(getCompileCommandsJsonPath(buildDirPath));
+            previousLinkCommands = JsonUtils::getJsonFromFile(getLinkCommandsJsonPath(buildDirPath));
         }
         LOG_S(INFO) << "Configure make project";
         RunProjectConfigurationCommand(buildDirPath, bearMakeParams, projectContext, writer);
+        if (incremental) {
+            mergeCommandsJson(getCompileCommandsJsonPath(buildDirPath), previousCompileCommands, false);
+            mergeCommandsJson(getLinkCommandsJsonPath(buildDirPath), previousLinkCommands, true);
+        }
+        FileSystemUtils::writeToFileAtomically(getConfigurationStatePath(buildDirPath), inputsHash);
         writer.writeResponse(ProjectConfigStatus::IS_OK);
     } catch (const std::exception &e) {
         fs::remove(getCompileCommandsJsonPath(buildDirPath));
         fs::remove(getLinkCommandsJsonPath(buildDirPath));
+        fs::remove(getConfigurationStatePath(buildDirPath));
         writer.writeResponse(ProjectConfigStatus::RUN_JSON_GENERATION_FAILED, e.what());
     }
     return Status::OK;
@@ -115,6 +151,173 @@ fs::path UserProjectConfiguration::getBearShScriptPath(const fs::path &buildDirP
     return buildDirPath / "bear.sh";
 }
 
+fs::path UserProjectConfiguration::getConfigurationStatePath(const fs::path &buildDirPath) {
+    return buildDirPath / "utbot_configuration_hash";
+}
+
+static bool isMakefile(const fs::path &path) {
+    std::string fileName = path.filename().string();
+    return fileName == "Makefile" || fileName == "makefile" || fileName == "GNUmakefile" ||
+           path.extension() == ".mk";
+}
+
+std::string
+UserProjectConfiguration::getConfigurationInputsHash(const fs::path &projectDirPath,
+                                                     const fs::path &buildDirPath,
+                                                     const std::vector<std::string> &cmakeOptions) {
+    // without CMake the commands are produced by the makefiles of the project
+    bool isCMakeProject = fs::exists(getCmakeListsPath(buildDirPath));
+    std::vector<fs::path> inputs;
+    std::filesystem::recursive_directory_iterator it(
+        projectDirPath.string(), std::filesystem::directory_options::skip_permission_denied);
+    for (; it != std::filesystem::recursive_directory_iterator(); ++it) {
+        const std::filesystem::path &entryPath = it->path();
+        std::string fileName = entryPath.filename().string();
+        if (it->is_directory()) {
+            // build directories and hidden directories like .git hold no inputs
+            if (fs::path(entryPath) == buildDirPath || StringUtils::startsWith(fileName, ".")) {
+                it.disable_recursion_pending();
+            }
+            continue;
+        }
+        if (!it->is_regular_file()) {
+            continue;
+        }
+        fs::path path = entryPath;
+        if (fileName == "CMakeLists.txt" || path.extension() == ".cmake" ||
+            (!isCMakeProject && isMakefile(path))) {
+            inputs.push_back(path);
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+    std::string summary = StringUtils::joinWith(cmakeOptions, " ") + "\n";
+    for (const fs::path &path : inputs) {
+        std::ifstream stream(path.string(), std::ios::binary);
+        std::string content(std::istreambuf_iterator<char>(stream), {});
+        summary += path.string() + " " + HashUtils::contentHash(content) + "\n";
+    }
+    return HashUtils::contentHash(summary);
+}
+
+bool UserProjectConfiguration::canCaptureIncrementally(const fs::path &buildDirPath,
+                                                       const std::string &inputsHash) {
+    return fs::exists(getCompileCommandsJsonPath(buildDirPath)) &&
+           fs::exists(getLinkCommandsJsonPath(buildDirPath)) &&
+           FileSystemUtils::hasContent(getConfigurationStatePath(buildDirPath), inputsHash);
+}
+
+static std::vector<std::string> getCommandArguments(const nlohmann::json &command) {
+    if (command.contains("command")) {
+        return StringUtils::splitByWhitespaces(command.at("command").get<std::string>());
+    }
+    return command.at("arguments").get<std::vector<std::string>>();
+}
+
+static fs::path getCommandFilePath(const fs::path &directory, const std::string &fileName) {
+    return fs::weakly_canonical(directory / fileName);
+}
+
+static utbot::CompileCommand parseCompileCommand(const nlohmann::json &command) {
+    fs::path directory = command.at("directory").get<std::string>();
+    fs::path sourceFile = Paths::getCCJsonFileFullPath(command.at("file").get<std::string>(), directory);
+    return { getCommandArguments(command), directory, sourceFile };
+}
+
+std::string UserProjectConfiguration::getCommandKey(const nlohmann::json &command, bool isLinkCommand) {
+    fs::path directory = command.at("directory").get<std::string>();
+    std::vector<std::string> arguments = getCommandArguments(command);
+    if (arguments.empty()) {
+        return directory.string();
+    }
+    if (isLinkCommand) {
+        // archive commands are followed by ranlib with the same output
+        std::string tool = fs::path(arguments.front()).filename().string();
+        utbot::LinkCommand linkCommand(arguments, directory);
+        return StringUtils::joinWith(
+            std::vector<std::string>{ directory.string(), tool, linkCommand.getOutput().string() }, " ");
+    }
+    utbot::CompileCommand compileCommand = parseCompileCommand(command);
+    return StringUtils::joinWith(
+        std::vector<std::string>{ directory.string(), compileCommand.getSourcePath().string(),
+                                  compileCommand.getOutput().string() }, " ");
+}
+
+/*
+ * Previous commands of deleted sources are not produced by the build anymore, and link
+ * commands can't refer to objects which have no compile command.
+ */
+static bool isStaleCommand(const nlohmann::json &command,
+                           bool isLinkCommand,
+                           const std::set<fs::path> &objectFiles) {
+    fs::path directory = command.at("directory").get<std::string>();
+    if (!isLinkCommand) {
+        return !fs::exists(getCommandFilePath(directory, command.at("file").get<std::string>()));
+    }
+    if (!command.contains("files")) {
+        return false;
+    }
+    return std::any_of(command.at("files").begin(), command.at("files").end(),
+                       [&](const nlohmann::json &file) {
+                           fs::path path = getCommandFilePath(directory, file.get<std::string>());
+                           return Paths::isObjectFile(path) &&
+                                  !CollectionUtils::contains(objectFiles, path);
+                       });
+}
+
+static std::set<fs::path> getObjectFiles(const fs::path &compileCommandsJsonPath) {
+    std::set<fs::path> objectFiles;
+    if (!fs::exists(compileCommandsJsonPath)) {
+        return objectFiles;
+    }
+    for (const nlohmann::json &command : JsonUtils::getJsonFromFile(compileCommandsJsonPath)) {
+        utbot::CompileCommand compileCommand = parseCompileCommand(command);
+        objectFiles.insert(
+            getCommandFilePath(compileCommand.getDirectory(), compileCommand.getOutput().string()));
+    }
+    return objectFiles;
+}
+
+void UserProjectConfiguration::mergeCommandsJson(const fs::path &jsonPath,
+                                                 const nlohmann::json &previousCommands,
+                                                 bool isLinkCommands) {
+    nlohmann::json newCommands = fs::exists(jsonPath) ? JsonUtils::getJsonFromFile(jsonPath)
+                                                      : nlohmann::json::array();
+    // compile commands are merged first, so link commands are checked against merged objects
+    std::set<fs::path> objectFiles;
+    if (isLinkCommands) {
+        objectFiles = getObjectFiles(getCompileCommandsJsonPath(jsonPath.parent_path()));
+    }
+    std::unordered_map<std::string, size_t> newCommandIndexes;
+    for (size_t i = 0; i < newCommands.size(); i++) {
+        newCommandIndexes.emplace(getCommandKey(newCommands[i], isLinkCommands), i);
+    }
+    nlohmann::json mergedCommands = nlohmann::json::array();
+    std::vector<bool> isMerged(newCommands.size(), false);
+    size_t staleCommandsCount = 0;
+    for (const nlohmann::json &command : previousCommands) {
+        auto it = newCommandIndexes.find(getCommandKey(command, isLinkCommands));
+        if (it == newCommandIndexes.end()) {
+            if (isStaleCommand(command, isLinkCommands, objectFiles)) {
+                staleCommandsCount++;
+            } else {
+                mergedCommands.push_back(command);
+            }
+        } else if (!isMerged[it->second]) {
+            mergedCommands.push_back(newCommands[it->second]);
+            isMerged[it->second] = true;
+        }
+    }
+    for (size_t i = 0; i < newCommands.size(); i++) {
+        if (!isMerged[i]) {
+            mergedCommands.push_back(newCommands[i]);
+        }
+    }
+    LOG_S(DEBUG) << newCommands.size() << " commands were rebuilt, " << staleCommandsCount
+                 << " stale commands were dropped, " << mergedCommands.size()
+                 << " commands are written to " << jsonPath;
+    JsonUtils::writeJsonToFile(jsonPath, mergedCommands);
+}
+
 static std::string getBearShEnvironmentSetting() {
     auto libraryDirs = {
             Paths::getUTBotDebsInstallDir() / "usr/lib/x86_64-linux-gnu",
@@ -142,8 +345,18 @@ Status UserProjectConfiguration::RunProjectReConfigurationCommands(const fs::pat
                                                                    const fs::path &projectDirPath,
                                                                    const utbot::ProjectContext &projectContext,
                                                                    std::vector<std::string> cmakeOptions,
-                                                                   ProjectConfigWriter const &writer) {
+                                                                   ProjectConfigWriter const &writer,
+                                                                   bool incremental) {
     try {
+        if (incremental) {
+            std::string inputsHash = getConfigurationInputsHash(
+                projectDirPath, buildDirPath, getCmakeOptionsWithMandatory(cmakeOptions));
+            if (canCaptureIncrementally(buildDirPath, inputsHash)) {
+                LOG_S(INFO) << "Build directory is kept, commands are captured incrementally";
+                return UserProjectConfiguration::RunProjectConfigurationCommands(
+                    buildDirPath, projectContext, cmakeOptions, writer, true);
+            }
+        }
         if (Paths::isSubPathOf(projectDirPath, buildDirPath)) {
             fs::remove_all(buildDirPath);
         } else {
@@ -159,7 +372,7 @@ Status UserProjectConfiguration::RunProjectReConfigurationCommands(const fs::pat
         return Status::OK;
     }
     return UserProjectConfiguration::RunProjectConfigurationCommands(buildDirPath, projectContext,
-                                                                     cmakeOptions, writer);
+                                                                     cmakeOptions, writer, clean);
 }
 
 bool UserProjectConfiguration::createBuildDirectory(const fs::path &buildDirPath,
@@ -4,11 +4,14 @@
 #include "streams/ProjectConfigWriter.h"
 #include "tasks/ShellExecTask.h"
 
+#include "json.hpp"
+
 #include <grpcpp/grpcpp.h>
 #include <protobuf/testgen.grpc.pb.h>
 
 #include "utils/path/FileSystemPath.h"
-
+#include <string>
+#include <vector>
 
 using grpc::Status;
 using testsgen::ProjectConfigStatus;
@@ -21,16 +24,46 @@ public:
     static Status RunBuildDirectoryCreation(const fs::path &buildDirPath,
                                             ProjectConfigWriter const &writer);
 
+    /**
+     * Captures compile and link commands of the project. If incremental is set and the inputs
+     * haven't changed since the previous capture, only the changed part is rebuilt.
+     */
     static Status RunProjectConfigurationCommands(const fs::path &buildDirPath,
                                                   const utbot::ProjectContext &projectContext,
                                                   std::vector<std::string> cmakeOptions,
-                                                  ProjectConfigWriter const &writer);
+                                                  ProjectConfigWriter const &writer,
+                                                  bool incremental = false);
 
     static Status RunProjectReConfigurationCommands(const fs::path &buildDirPath,
                                                     const fs::path &projectDirPath,
                                                     const utbot::ProjectContext &projectContext,
                                                     std::vector<std::string> cmakeOptions,
-                                                    ProjectConfigWriter const &writer);
+                                                    ProjectConfigWriter const &writer,
+                                                    bool incremental = false);
+
+    /**
+     * Hash of all configuration inputs of the project and of the cmake options. Inputs are
+     * CMakeLists.txt and *.cmake files, and makefiles if the project has no root
+     * CMakeLists.txt. The build directory and hidden directories are not searched.
+     */
+    static std::string getConfigurationInputsHash(const fs::path &projectDirPath,
+                                                  const fs::path &buildDirPath,
+                                                  const std::vector<std::string> &cmakeOptions);
+
+    /**
+     * Key of a command that is equal for commands which produce the same output, so a rerun
+     * command replaces its previous version.
+     */
+    static std::string getCommandKey(const nlohmann::json &command, bool isLinkCommand);
+
+    /**
+     * Adds commands of the previous capture which weren't rerun by the incremental build
+     * to the commands written by bear. Commands of deleted sources and link commands of
+     * their objects are dropped.
+     */
+    static void mergeCommandsJson(const fs::path &jsonPath,
+                                  const nlohmann::json &previousCommands,
+                                  bool isLinkCommands);
 
 private:
     static void RunProjectConfigurationCommand(const fs::path &buildDirPath,
@@ -46,6 +79,18 @@ private:
 
     static fs::path getBearShScriptPath(const fs::path &buildDirPath);
 
+    static fs::path getConfigurationStatePath(const fs::path &buildDirPath);
+
+    /**
+     * Returns true if commands of the build directory were captured with the same CMake
+     * inputs, so only the changed part of the project has to be rebuilt.
+     */
+    static bool canCaptureIncrementally(const fs::path &buildDirPath,
+                                        const std::string &inputsHash);
+
+    static std::vector<std::string>
+    getCmakeOptionsWithMandatory(const std::vector<std::string> &cmakeOptions);
+
     static fs::path createBearShScript(const fs::path &buildDirPath);
 
     static bool createBuildDirectory(const fs::path &buildDirPath, ProjectConfigWriter const &writer);
@@ -0,0 +1,55 @@
+#include "PreprocessedHashAction.h"
+
+#include "utils/ExecUtils.h"
+#include "utils/HashUtils.h"
+
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Lex/Preprocessor.h>
+#include <llvm/ADT/SmallString.h>
+
+#include <string_view>
+
+PreprocessedHashAction::PreprocessedHashAction(std::size_t *hash,
+                                               CollectionUtils::MapFileTo<uint64_t> *inputFiles)
+    : hash(hash), inputFiles(inputFiles) {
+}
+
+void PreprocessedHashAction::ExecuteAction() {
+    ExecUtils::throwIfCancelled();
+    clang::Preprocessor &preprocessor = getCompilerInstance().getPreprocessor();
+    preprocessor.IgnorePragmas();
+    preprocessor.EnterMainSourceFile();
+    clang::Token token;
+    llvm::SmallString<64> buffer;
+    while (true) {
+        preprocessor.Lex(token);
+        if (token.is(clang::tok::eof)) {
+            break;
+        }
+        llvm::StringRef spelling = preprocessor.getSpelling(token, buffer);
+        HashUtils::hashCombine(*hash, std::string_view(spelling.data(), spelling.size()));
+    }
+    clang::SourceManager &sourceManager = getCompilerInstance().getSourceManager();
+    for (auto it = sourceManager.fileinfo_begin(); it != sourceManager.fileinfo_end(); ++it) {
+        const clang::FileEntry *fileEntry = it->first;
+        // names may be relative to the directory of the command, real names are absolute
+        llvm::StringRef name = fileEntry->tryGetRealPathName();
+        if (name.empty()) {
+            name = fileEntry->getName();
+        }
+        (*inputFiles)[fs::path(name.str())] = static_cast<uint64_t>(fileEntry->getSize());
+    }
+}
+
+std::unique_ptr<clang::FrontendAction> PreprocessedHashActionFactory::create() {
+    return std::make_unique<PreprocessedHashAction>(&hash, &inputFiles);
+}
+
+std::size_t PreprocessedHashActionFactory::getHash() const {
+    return hash;
+}
+
+const CollectionUtils::MapFileTo<uint64_t> &PreprocessedHashActionFactory::getInputFiles() const {
+    return inputFiles;
+}
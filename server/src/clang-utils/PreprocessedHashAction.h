@@ -0,0 +1,52 @@
+#ifndef UNITTESTBOT_PREPROCESSEDHASHACTION_H
+#define UNITTESTBOT_PREPROCESSEDHASHACTION_H
+
+#include "utils/CollectionUtils.h"
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/Tooling.h>
+
+#include <memory>
+
+/**
+ * Preprocesses translation unit and hashes spellings of the resulting tokens. Comments,
+ * formatting and unused macros do not affect the hash, while changes of included files
+ * and compilation flags do. It is much cheaper than parsing the translation unit.
+ */
+class PreprocessedHashAction : public clang::PreprocessorFrontendAction {
+public:
+    /**
+     * @param inputFiles receives files read by the preprocessor with their sizes at the time
+     * they were read.
+     */
+    PreprocessedHashAction(std::size_t *hash, CollectionUtils::MapFileTo<uint64_t> *inputFiles);
+
+protected:
+    void ExecuteAction() override;
+
+private:
+    std::size_t *hash;
+    CollectionUtils::MapFileTo<uint64_t> *inputFiles;
+};
+
+/**
+ * Combines hashes of all compilation commands of the file.
+ */
+class PreprocessedHashActionFactory : public clang::tooling::FrontendActionFactory {
+public:
+    std::unique_ptr<clang::FrontendAction> create() override;
+
+    [[nodiscard]] std::size_t getHash() const;
+
+    /**
+     * Files read by the preprocessor in all compilation commands of the file.
+     */
+    [[nodiscard]] const CollectionUtils::MapFileTo<uint64_t> &getInputFiles() const;
+
+private:
+    std::size_t hash = 0;
+    CollectionUtils::MapFileTo<uint64_t> inputFiles;
+};
+
+
+#endif // UNITTESTBOT_PREPROCESSEDHASHACTION_H
@@ -162,30 +162,13 @@ void SourceToHeaderMatchCallback::handleTypedef(const TypedefDecl *decl) {
 }
 
 void SourceToHeaderMatchCallback::handleFunctionDecl(const FunctionDecl *decl) {
-    // remove static modifier
-    auto storageClass = decl->getStorageClass();
-    bool isInlineSpecified = decl->isInlineSpecified();
-    auto *mutableDecl = const_cast<FunctionDecl *>(decl);
-    mutableDecl->setStorageClass(SC_None);
-    // remove inline modifier
-    mutableDecl->setInlineSpecified(false);
-
     generateInternal(decl);
     generateWrapper(decl);
-
-    mutableDecl->setInlineSpecified(isInlineSpecified);
-    mutableDecl->setStorageClass(storageClass);
 }
 
 void SourceToHeaderMatchCallback::handleVarDecl(const VarDecl *decl) {
-    StorageClass storageClass = decl->getStorageClass();
-    auto *mutableDecl = const_cast<VarDecl *>(decl);
-    mutableDecl->setStorageClass(SC_None);
-
     generateInternal(decl);
     generateWrapper(decl);
-
-    mutableDecl->setStorageClass(storageClass);
 }
 
 void SourceToHeaderMatchCallback::generateInternal(const FunctionDecl *decl) const {
@@ -226,9 +209,6 @@ void SourceToHeaderMatchCallback::generateInternal(const VarDecl *decl) const {
     std::string wrapperPointerName = stringFormat("(*%s)", wrapperName);
     std::string refName = stringFormat("(&%s)", decoratedName);
 
-    std::string curDecl;
-    llvm::raw_string_ostream curDeclStream{ curDecl };
-    decl->print(curDeclStream, policy);
     std::string wrapperPointerDecl =
         getRenamedDeclarationAsString(decl, policy, wrapperPointerName);
     std::string refDecl = getRenamedDeclarationAsString(decl, policy, refName);
@@ -349,16 +329,56 @@ SourceToHeaderMatchCallback::getRenamedDeclarationAsString(const clang::NamedDec
                                                            std::string const &name) const {
     std::string result;
     llvm::raw_string_ostream resultStream{ result };
-    auto curDeclName = decl->getDeclName();
-    renameDecl(decl, name);
-    decl->print(resultStream, policy);
-    const_cast<NamedDecl *>(decl)->setDeclName(curDeclName);
+    if (const auto *functionDecl = llvm::dyn_cast<FunctionDecl>(decl)) {
+        copyFunctionDecl(functionDecl, name)->print(resultStream, policy);
+    } else if (const auto *varDecl = llvm::dyn_cast<VarDecl>(decl)) {
+        copyVarDecl(varDecl, name)->print(resultStream, policy);
+    } else {
+        // copying a tag or typedef would mean copying its members, so it is renamed in place
+        ScopedRename rename{ decl, name };
+        decl->print(resultStream, policy);
+    }
     resultStream.flush();
     return result;
 }
 
-void SourceToHeaderMatchCallback::renameDecl(const NamedDecl *decl, const std::string &name) const {
-    auto &info = decl->getASTContext().Idents.get(name);
-    DeclarationName wrapperDeclarationName{ &info };
-    const_cast<NamedDecl *>(decl)->setDeclName(wrapperDeclarationName);
+FunctionDecl *SourceToHeaderMatchCallback::copyFunctionDecl(const FunctionDecl *decl,
+                                                            const std::string &name) {
+    ASTContext &context = decl->getASTContext();
+    DeclarationName declarationName{ &context.Idents.get(name) };
+    // storage class and inline specifier are dropped: static and inline functions are exported
+    auto *copy = FunctionDecl::Create(
+        context, const_cast<DeclContext *>(decl->getDeclContext()), decl->getBeginLoc(),
+        decl->getLocation(), declarationName, decl->getType(), decl->getTypeSourceInfo(), SC_None,
+        false, decl->hasWrittenPrototype(), decl->getConstexprKind());
+    copy->setParams(decl->parameters());
+    // K&R definitions print their parameter names only when they have a body
+    copy->setBody(decl->getBody());
+    if (decl->hasAttrs()) {
+        copy->setAttrs(decl->getAttrs());
+    }
+    return copy;
+}
+
+VarDecl *SourceToHeaderMatchCallback::copyVarDecl(const VarDecl *decl, const std::string &name) {
+    ASTContext &context = decl->getASTContext();
+    auto *copy = VarDecl::Create(context, const_cast<DeclContext *>(decl->getDeclContext()),
+                                 decl->getBeginLoc(), decl->getLocation(),
+                                 &context.Idents.get(name), decl->getType(),
+                                 decl->getTypeSourceInfo(), SC_None);
+    copy->setTSCSpec(decl->getTSCSpec());
+    if (decl->hasAttrs()) {
+        copy->setAttrs(decl->getAttrs());
+    }
+    return copy;
+}
+
+SourceToHeaderMatchCallback::ScopedRename::ScopedRename(const NamedDecl *decl,
+                                                        const std::string &name)
+    : decl(const_cast<NamedDecl *>(decl)), previousName(decl->getDeclName()) {
+    this->decl->setDeclName(DeclarationName{ &decl->getASTContext().Idents.get(name) });
+}
+
+SourceToHeaderMatchCallback::ScopedRename::~ScopedRename() {
+    decl->setDeclName(previousName);
 }
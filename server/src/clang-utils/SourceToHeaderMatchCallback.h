@@ -84,7 +84,33 @@ private:
                                               clang::PrintingPolicy const &policy,
                                               std::string const &name) const;
 
-    void renameDecl(const clang::NamedDecl *decl, const std::string &name) const;
+    /**
+     * Matched declarations are shared with other consumers of the AST, so functions and
+     * variables are printed through detached copies under the new name instead of being changed.
+     */
+    static clang::FunctionDecl *copyFunctionDecl(const clang::FunctionDecl *decl,
+                                                 const std::string &name);
+
+    static clang::VarDecl *copyVarDecl(const clang::VarDecl *decl, const std::string &name);
+
+    /**
+     * Renames a declaration for the lifetime of the object and restores the original name
+     * afterwards, even if printing throws.
+     */
+    class ScopedRename {
+    public:
+        ScopedRename(const clang::NamedDecl *decl, const std::string &name);
+
+        ~ScopedRename();
+
+        ScopedRename(const ScopedRename &) = delete;
+
+        ScopedRename &operator=(const ScopedRename &) = delete;
+
+    private:
+        clang::NamedDecl *decl;
+        clang::DeclarationName previousName;
+    };
 
     std::string decorate(std::string_view name) const;
 };
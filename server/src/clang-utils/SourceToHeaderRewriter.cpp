@@ -1,15 +1,70 @@
 #include "SourceToHeaderRewriter.h"
 
 #include "NameDecorator.h"
+#include "PreprocessedHashAction.h"
 #include "SettingsContext.h"
 #include "SourceToHeaderMatchCallback.h"
 #include "utils/Copyright.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/HashUtils.h"
+#include "utils/LRUCache.h"
 #include "utils/LogUtils.h"
 
 #include "loguru.h"
 
 #include <utility>
+#include <algorithm>
 #include <fstream>
+#include <mutex>
+#include <optional>
+
+namespace {
+    struct InputFile {
+        fs::path path;
+        FileSystemUtils::FileStamp stamp;
+    };
+
+    struct CachedOutputs {
+        std::size_t preprocessedHash;
+        // files read by the preprocessor, empty if they changed while they were read
+        std::vector<InputFile> inputFiles;
+        std::size_t structsToDeclareHash;
+        std::shared_ptr<const SourceToHeaderRewriter::SourceOutputs> outputs;
+    };
+
+    // source file and hash of its compilation commands and project
+    using CacheKey = std::pair<fs::path, std::size_t>;
+
+    // headers and wrappers are regenerated by every request, so recently used outputs are kept
+    const size_t MAX_CACHED_SOURCE_OUTPUTS = 1024;
+
+    std::mutex sourceOutputsMutex;
+    LRUCache<CacheKey, CachedOutputs> sourceOutputs(MAX_CACHED_SOURCE_OUTPUTS);
+
+    std::vector<InputFile> getInputFiles(const CollectionUtils::MapFileTo<uint64_t> &readFiles) {
+        std::vector<InputFile> inputFiles;
+        for (const auto &[path, readSize] : readFiles) {
+            auto stamp = FileSystemUtils::getFileStamp(path);
+            if (!stamp.has_value() || stamp->size != readSize) {
+                return {};
+            }
+            inputFiles.push_back({ path, stamp.value() });
+        }
+        return inputFiles;
+    }
+
+    bool inputFilesUnchanged(const std::vector<InputFile> &inputFiles) {
+        return !inputFiles.empty() &&
+               std::all_of(inputFiles.begin(), inputFiles.end(), [](const InputFile &inputFile) {
+                   return FileSystemUtils::getFileStamp(inputFile.path) == inputFile.stamp;
+               });
+    }
+
+    void storeCached(const CacheKey &key, CachedOutputs cachedOutputs) {
+        std::lock_guard<std::mutex> lock(sourceOutputsMutex);
+        sourceOutputs.put(key, std::move(cachedOutputs));
+    }
+}
 
 SourceToHeaderRewriter::SourceToHeaderRewriter(
     utbot::ProjectContext projectContext,
@@ -17,33 +72,34 @@ SourceToHeaderRewriter::SourceToHeaderRewriter(
     std::shared_ptr<Fetcher::FileToStringSet> structsToDeclare,
     fs::path serverBuildDir)
     : projectContext(std::move(projectContext)),
-      clangToolRunner(compilationDatabase), structsToDeclare(structsToDeclare),
+      clangToolRunner(compilationDatabase), compilationDatabase(compilationDatabase),
+      structsToDeclare(structsToDeclare),
       serverBuildDir(std::move(serverBuildDir)) {
 }
 
-std::unique_ptr<clang::tooling::FrontendActionFactory>
-SourceToHeaderRewriter::createFactory(llvm::raw_ostream *externalStream,
-                                      llvm::raw_ostream *internalStream,
-                                      llvm::raw_ostream *wrapperStream,
-                                      fs::path sourceFilePath,
-                                      bool forStubHeader) {
-    fetcherInstance = std::make_unique<SourceToHeaderMatchCallback>(
-        projectContext, sourceFilePath, externalStream, internalStream, wrapperStream, forStubHeader);
+void SourceToHeaderRewriter::addCallback(llvm::raw_ostream *externalStream,
+                                         llvm::raw_ostream *internalStream,
+                                         llvm::raw_ostream *wrapperStream,
+                                         const fs::path &sourceFilePath,
+                                         bool forStubHeader) {
+    callbacks.push_back(std::make_unique<SourceToHeaderMatchCallback>(
+        projectContext, sourceFilePath, externalStream, internalStream, wrapperStream,
+        forStubHeader));
+}
+
+std::unique_ptr<clang::tooling::FrontendActionFactory> SourceToHeaderRewriter::createFactory() {
+    // callbacks are called one after another for every match, so the AST is traversed once
     finder = std::make_unique<clang::ast_matchers::MatchFinder>();
-    finder->addMatcher(Matchers::anyToplevelDeclarationMatcher, fetcherInstance.get());
+    for (auto const &callback : callbacks) {
+        finder->addMatcher(Matchers::anyToplevelDeclarationMatcher, callback.get());
+    }
     return clang::tooling::newFrontendActionFactory(finder.get());
 }
 
-SourceToHeaderRewriter::SourceDeclarations
-SourceToHeaderRewriter::generateSourceDeclarations(const fs::path &sourceFilePath, bool forStubHeader) {
-    std::string externalDeclarations;
-    llvm::raw_string_ostream externalStream(externalDeclarations);
-    std::string internalDeclarations;
-    llvm::raw_string_ostream internalStream(internalDeclarations);
-
-    auto factory = createFactory(&externalStream, &internalStream, nullptr, sourceFilePath, forStubHeader);
-
-    if (CollectionUtils::containsKey(*structsToDeclare, sourceFilePath)) {
+void SourceToHeaderRewriter::runOnSource(const fs::path &sourceFilePath,
+                                         clang::tooling::ToolAction *toolAction) {
+    if (structsToDeclare != nullptr &&
+        CollectionUtils::containsKey(*structsToDeclare, sourceFilePath)) {
         std::stringstream newContentStream;
         for (std::string const &structName : structsToDeclare->at(sourceFilePath)) {
             newContentStream << StringUtils::stringFormat("struct %s;\n", structName);
@@ -51,16 +107,140 @@ SourceToHeaderRewriter::generateSourceDeclarations(const fs::path &sourceFilePat
         std::ifstream oldFileStream(sourceFilePath);
         newContentStream << oldFileStream.rdbuf();
         std::string content = newContentStream.str();
-        clangToolRunner.run(sourceFilePath, factory.get(), false, content);
+        clangToolRunner.run(sourceFilePath, toolAction, false, content);
     } else {
-        clangToolRunner.run(sourceFilePath, factory.get());
+        clangToolRunner.run(sourceFilePath, toolAction);
     }
+}
+
+std::pair<std::size_t, CollectionUtils::MapFileTo<uint64_t>>
+SourceToHeaderRewriter::getPreprocessedHash(const fs::path &sourceFilePath) {
+    PreprocessedHashActionFactory factory;
+    clangToolRunner.run(sourceFilePath, &factory);
+    return { factory.getHash(), factory.getInputFiles() };
+}
+
+std::size_t SourceToHeaderRewriter::getCommandsHash(const fs::path &sourceFilePath) const {
+    // names of wrappers depend on project path
+    std::size_t hash = std::hash<std::string>()(projectContext.projectPath.string());
+    for (const auto &command :
+         compilationDatabase->getClangCompilationDatabase().getCompileCommands(
+             sourceFilePath.string())) {
+        HashUtils::hashCombine(hash, command.Directory);
+        for (const auto &argument : command.CommandLine) {
+            HashUtils::hashCombine(hash, argument);
+        }
+    }
+    return hash;
+}
+
+std::size_t
+SourceToHeaderRewriter::getStructsToDeclareHash(const fs::path &sourceFilePath) const {
+    std::size_t hash = 0;
+    if (structsToDeclare != nullptr &&
+        CollectionUtils::containsKey(*structsToDeclare, sourceFilePath)) {
+        for (std::string const &structName : structsToDeclare->at(sourceFilePath)) {
+            HashUtils::hashCombine(hash, structName);
+        }
+    }
+    return hash;
+}
+
+SourceToHeaderRewriter::SourceDeclarations
+SourceToHeaderRewriter::generateSourceDeclarations(const fs::path &sourceFilePath, bool forStubHeader) {
+    std::string externalDeclarations;
+    llvm::raw_string_ostream externalStream(externalDeclarations);
+    std::string internalDeclarations;
+    llvm::raw_string_ostream internalStream(internalDeclarations);
+
+    callbacks.clear();
+    addCallback(&externalStream, &internalStream, nullptr, sourceFilePath, forStubHeader);
+    auto factory = createFactory();
+    runOnSource(sourceFilePath, factory.get());
     externalStream.flush();
     internalStream.flush();
 
     return { externalDeclarations, internalDeclarations };
 }
 
+std::string SourceToHeaderRewriter::generateSourceWrapper(const fs::path &sourceFilePath) {
+    std::string result;
+    llvm::raw_string_ostream wrapperStream(result);
+    callbacks.clear();
+    addCallback(nullptr, nullptr, &wrapperStream, sourceFilePath, false);
+    auto factory = createFactory();
+    clangToolRunner.run(sourceFilePath, factory.get());
+    wrapperStream.flush();
+    return result;
+}
+
+SourceToHeaderRewriter::SourceOutputs
+SourceToHeaderRewriter::generateSourceOutputs(const fs::path &sourceFilePath) {
+    SourceOutputs outputs;
+    llvm::raw_string_ostream externalStream(outputs.testDeclarations.externalDeclarations);
+    llvm::raw_string_ostream internalStream(outputs.testDeclarations.internalDeclarations);
+    llvm::raw_string_ostream stubStream(outputs.stubDeclarations);
+    llvm::raw_string_ostream wrapperStream(outputs.wrapper);
+
+    // C++ sources are included by their tests as is and get no wrapper, only a stub header
+    bool isCFile = Paths::isCFile(sourceFilePath);
+    // the wrapper is compiled with the original source, so it must not see declared structs
+    bool withStructs = structsToDeclare != nullptr &&
+                       CollectionUtils::containsKey(*structsToDeclare, sourceFilePath);
+    callbacks.clear();
+    addCallback(&stubStream, nullptr, nullptr, sourceFilePath, true);
+    if (isCFile) {
+        addCallback(&externalStream, &internalStream, nullptr, sourceFilePath, false);
+        if (!withStructs) {
+            addCallback(nullptr, nullptr, &wrapperStream, sourceFilePath, false);
+        }
+    }
+    auto factory = createFactory();
+    runOnSource(sourceFilePath, factory.get());
+    externalStream.flush();
+    internalStream.flush();
+    stubStream.flush();
+    wrapperStream.flush();
+
+    if (isCFile && withStructs) {
+        outputs.wrapper = generateSourceWrapper(sourceFilePath);
+    }
+    return outputs;
+}
+
+std::shared_ptr<const SourceToHeaderRewriter::SourceOutputs>
+SourceToHeaderRewriter::getSourceOutputs(const fs::path &sourceFilePath, bool wrapperOnly) {
+    CacheKey key{ sourceFilePath, getCommandsHash(sourceFilePath) };
+    std::size_t structsToDeclareHash = getStructsToDeclareHash(sourceFilePath);
+    auto reusable = [&](const CachedOutputs &cached) {
+        return wrapperOnly || cached.structsToDeclareHash == structsToDeclareHash;
+    };
+    std::optional<CachedOutputs> previous;
+    {
+        std::lock_guard<std::mutex> lock(sourceOutputsMutex);
+        const CachedOutputs *cached = sourceOutputs.get(key);
+        if (cached != nullptr && reusable(*cached)) {
+            previous = *cached;
+        }
+    }
+    if (previous.has_value() && inputFilesUnchanged(previous->inputFiles)) {
+        LOG_S(DEBUG) << "Source and its includes are not changed, reusing generated code for "
+                     << sourceFilePath;
+        return previous->outputs;
+    }
+    auto [preprocessedHash, readFiles] = getPreprocessedHash(sourceFilePath);
+    std::vector<InputFile> inputFiles = getInputFiles(readFiles);
+    if (previous.has_value() && previous->preprocessedHash == preprocessedHash) {
+        LOG_S(DEBUG) << "Preprocessed source is not changed, reusing generated code for "
+                     << sourceFilePath;
+        previous->inputFiles = std::move(inputFiles);
+        storeCached(key, previous.value());
+        return previous->outputs;
+    }
+    auto outputs = std::make_shared<const SourceOutputs>(generateSourceOutputs(sourceFilePath));
+    storeCached(key, { preprocessedHash, std::move(inputFiles), structsToDeclareHash, outputs });
+    return outputs;
+}
 
 std::string SourceToHeaderRewriter::generateTestHeader(const fs::path &sourceFilePath,
                                                        const Tests &test) {
@@ -76,8 +256,12 @@ std::string SourceToHeaderRewriter::generateTestHeader(const fs::path &sourceFil
                                          sourceFileToInclude);
     }
 
-    auto sourceDeclarations = generateSourceDeclarations(sourceFilePath, false);
+    auto outputs = getSourceOutputs(sourceFilePath, false);
+    return printTestHeader(outputs->testDeclarations);
+}
 
+std::string
+SourceToHeaderRewriter::printTestHeader(const SourceDeclarations &sourceDeclarations) {
     return StringUtils::stringFormat(
         "%s\n"
         "namespace %s {\n"
@@ -96,22 +280,34 @@ std::string SourceToHeaderRewriter::generateTestHeader(const fs::path &sourceFil
         NameDecorator::UNDEF_WCHAR_T, NameDecorator::UNDEFS_CODE);
 }
 
-std::string SourceToHeaderRewriter::generateStubHeader(const fs::path &sourceFilePath) {
+std::string SourceToHeaderRewriter::generateStubHeader(const fs::path &sourceFilePath,
+                                                       const fs::path &stubHeaderPath) {
     MEASURE_FUNCTION_EXECUTION_TIME
     LOG_IF_S(WARNING, Paths::isCXXFile(sourceFilePath))
         << "Stubs feature for C++ sources has not been tested thoroughly; some problems may occur";
-    auto sourceDeclarations = generateSourceDeclarations(sourceFilePath, true);
-    long long creationTime = TimeUtils::convertFileToSystemClock(fs::file_time_type::clock::now())
-                                 .time_since_epoch()
-                                 .count();
-    return StringUtils::stringFormat(
-        "//%s\n"
+    auto outputs = getSourceOutputs(sourceFilePath, false);
+    return printStubHeader(outputs->stubDeclarations, stubHeaderPath);
+}
+
+std::string SourceToHeaderRewriter::printStubHeader(const std::string &stubDeclarations,
+                                                    const fs::path &stubHeaderPath) {
+    std::string body = StringUtils::stringFormat(
         "//Please, do not change the line above\n"
         "%s\n"
         "#define _Alignas(x)\n"
         "%s\n",
-        std::to_string(creationTime), Copyright::GENERATED_C_CPP_FILE_HEADER,
-        sourceDeclarations.externalDeclarations);
+        Copyright::GENERATED_C_CPP_FILE_HEADER, stubDeclarations);
+
+    std::ifstream stubHeaderStream(stubHeaderPath);
+    std::string creationTimeLine;
+    if (getline(stubHeaderStream, creationTimeLine) &&
+        std::string(std::istreambuf_iterator<char>(stubHeaderStream), {}) == body) {
+        return creationTimeLine + "\n" + body;
+    }
+    long long creationTime = TimeUtils::convertFileToSystemClock(fs::file_time_type::clock::now())
+                                 .time_since_epoch()
+                                 .count();
+    return "//" + std::to_string(creationTime) + "\n" + body;
 }
 
 std::string SourceToHeaderRewriter::generateWrapper(const fs::path &sourceFilePath) {
@@ -119,12 +315,12 @@ std::string SourceToHeaderRewriter::generateWrapper(const fs::path &sourceFilePa
     if (!Paths::isCFile(sourceFilePath)) {
         return "";
     }
-    std::string result;
-    llvm::raw_string_ostream wrapperStream(result);
-    auto factory = createFactory(nullptr, nullptr, &wrapperStream, sourceFilePath, false);
-    clangToolRunner.run(sourceFilePath, factory.get());
-    wrapperStream.flush();
-    return result;
+    return getSourceOutputs(sourceFilePath, true)->wrapper;
+}
+
+void SourceToHeaderRewriter::clearCachedSourceOutputs() {
+    std::lock_guard<std::mutex> lock(sourceOutputsMutex);
+    sourceOutputs.clear();
 }
 
 void SourceToHeaderRewriter::generateTestHeaders(tests::TestsMap &tests,
@@ -15,25 +15,62 @@
 #include <clang/Rewrite/Core/Rewriter.h>
 #include <grpcpp/grpcpp.h>
 
+#include <memory>
 #include <utility>
+#include <vector>
 
 class SourceToHeaderRewriter {
     const utbot::ProjectContext projectContext;
 
     ClangToolRunner clangToolRunner;
+    std::shared_ptr<CompilationDatabase> compilationDatabase;
     fs::path projectPath;
     fs::path serverBuildDir;
     std::shared_ptr<Fetcher::FileToStringSet> structsToDeclare;
 
-    std::unique_ptr<clang::ast_matchers::MatchFinder::MatchCallback> fetcherInstance;
+    std::vector<std::unique_ptr<clang::ast_matchers::MatchFinder::MatchCallback>> callbacks;
     std::unique_ptr<clang::ast_matchers::MatchFinder> finder;
 
-    std::unique_ptr<clang::tooling::FrontendActionFactory>
-    createFactory(llvm::raw_ostream *externalStream,
-                  llvm::raw_ostream *internalStream,
-                  llvm::raw_ostream *wrapperStream,
-                  fs::path sourceFilePath,
-                  bool forStubHeader);
+    void addCallback(llvm::raw_ostream *externalStream,
+                     llvm::raw_ostream *internalStream,
+                     llvm::raw_ostream *wrapperStream,
+                     const fs::path &sourceFilePath,
+                     bool forStubHeader);
+
+    std::unique_ptr<clang::tooling::FrontendActionFactory> createFactory();
+
+    void runOnSource(const fs::path &sourceFilePath, clang::tooling::ToolAction *toolAction);
+
+    /**
+     * @return hash of the preprocessed source and files read by the preprocessor with their sizes.
+     */
+    std::pair<std::size_t, CollectionUtils::MapFileTo<uint64_t>>
+    getPreprocessedHash(const fs::path &sourceFilePath);
+
+    std::size_t getCommandsHash(const fs::path &sourceFilePath) const;
+
+    std::size_t getStructsToDeclareHash(const fs::path &sourceFilePath) const;
+
+public:
+    struct SourceOutputs;
+
+private:
+    /**
+     * Fills all outputs of the source in one parse of the translation unit. Test declarations
+     * and the wrapper are generated for C sources only. The wrapper is compiled against the
+     * original source, so it gets a separate pass when structs have to be declared.
+     */
+    SourceOutputs generateSourceOutputs(const fs::path &sourceFilePath);
+
+    /**
+     * Outputs are reused from the previous pass over the source with the same compilation
+     * commands. Preprocessing is skipped if no file read by the preprocessor has changed its
+     * size or modification time, otherwise outputs are reused if the preprocessed source is
+     * the same. Wrapper does not depend on declared structs, so it is reused even if the pass
+     * was run with different structsToDeclare.
+     */
+    std::shared_ptr<const SourceOutputs> getSourceOutputs(const fs::path &sourceFilePath,
+                                                          bool wrapperOnly);
 
 public:
     struct SourceDeclarations {
@@ -41,6 +78,16 @@ public:
         std::string internalDeclarations;
     };
 
+    /**
+     * Everything that is generated from the AST of the source: declarations for the test
+     * header, declarations for the stub header and the wrapper.
+     */
+    struct SourceOutputs {
+        SourceDeclarations testDeclarations;
+        std::string stubDeclarations;
+        std::string wrapper;
+    };
+
     friend class SourceToHeaderMatchCallback;
 
     SourceToHeaderRewriter(
@@ -53,10 +100,30 @@ public:
 
     std::string generateTestHeader(const fs::path &sourceFilePath, const Tests &test);
 
-    std::string generateStubHeader(const fs::path &sourceFilePath);
+    /**
+     * Creation time of the existing stub header is kept if the header
+     * does not change, so the header is not rewritten.
+     * @param stubHeaderPath path of the previously generated stub header.
+     */
+    std::string generateStubHeader(const fs::path &sourceFilePath, const fs::path &stubHeaderPath);
 
     std::string generateWrapper(const fs::path &sourceFilePath);
 
+    /**
+     * Generates the wrapper in a separate pass over the original source, bypassing the cache.
+     */
+    std::string generateSourceWrapper(const fs::path &sourceFilePath);
+
+    static std::string printTestHeader(const SourceDeclarations &sourceDeclarations);
+
+    static std::string printStubHeader(const std::string &stubDeclarations,
+                                       const fs::path &stubHeaderPath);
+
+    /**
+     * Drops outputs kept from previous passes, so the next request parses sources again.
+     */
+    static void clearCachedSourceOutputs();
+
     void generateTestHeaders(tests::TestsMap &tests, ProgressWriter const *progressWriter);
 };
 
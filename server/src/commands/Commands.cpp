@@ -455,6 +455,15 @@ Commands::RunTestsCommandOptions::RunTestsCommandOptions(Commands::RunTestsComma
                                            "Flag that controls coverage generation.");
     commands.getRunProjectCommand()->add_flag("--no-coverage", noCoverage,
                                               "Flag that controls coverage generation.");
+    for (CLI::App *command : { commands.getRunTestCommand(), commands.getRunFileCommand(),
+                               commands.getRunProjectCommand() }) {
+        command->add_flag("--sanitize-failed-only", sanitizeFailedOnly,
+                          "Run tests without sanitizers and rerun with them only tests "
+                          "that didn't pass.");
+        command->add_flag("--coverage-only", onlyCoverage,
+                          "Run every test binary once and collect only coverage, "
+                          "results of tests are not reported.");
+    }
 }
 
 fs::path Commands::RunTestsCommandOptions::getFilePath() {
@@ -473,6 +482,14 @@ bool Commands::RunTestsCommandOptions::withCoverage() const {
     return !noCoverage;
 }
 
+bool Commands::RunTestsCommandOptions::sanitizeFailedTestsOnly() const {
+    return sanitizeFailedOnly;
+}
+
+bool Commands::RunTestsCommandOptions::coverageOnly() const {
+    return onlyCoverage;
+}
+
 Commands::AllCommandOptions::AllCommandOptions(CLI::App *command) : allCommand(command) {
     allCommand->add_option("--no-coverage", noCoverage, "Flag that controls coverage generation.");
     allCommand->add_option(srcPathsFlag, srcPaths, srcPathsDescription);
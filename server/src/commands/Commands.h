@@ -188,12 +188,18 @@ namespace Commands {
 
         [[nodiscard]] bool withCoverage() const;
 
+        [[nodiscard]] bool sanitizeFailedTestsOnly() const;
+
+        [[nodiscard]] bool coverageOnly() const;
+
     private:
         fs::path filePath;
         std::string testSuite;
         std::string testName;
 
         bool noCoverage = false;
+        bool sanitizeFailedOnly = false;
+        bool onlyCoverage = false;
     };
 
     struct AllCommandOptions : public GenerateBaseCommandsOptions {
@@ -8,6 +8,8 @@
 
 #include "loguru.h"
 
+#include <mutex>
+
 using grpc::Status;
 using grpc::StatusCode;
 
@@ -19,7 +21,9 @@ CoverageAndResultsGenerator::CoverageAndResultsGenerator(
                  coverageAndResultsRequest->testfilter().testsuite(),
                  coverageAndResultsRequest->testfilter().testname(),
                  coverageAndResultsWriter),
-      coverageAndResultsWriter(coverageAndResultsWriter) {
+      coverageAndResultsWriter(coverageAndResultsWriter),
+      sanitizeFailedTestsOnly(coverageAndResultsRequest->sanitizefailedtestsonly()),
+      coverageOnly(coverageAndResultsRequest->coverageonly()) {
 }
 
 grpc::Status CoverageAndResultsGenerator::generate(bool withCoverage,
@@ -32,10 +36,26 @@ grpc::Status CoverageAndResultsGenerator::generate(bool withCoverage,
                                                    utbot::SettingsContext &settingsContext) {
     MEASURE_FUNCTION_EXECUTION_TIME
     try {
+        if (coverageOnly) {
+            init(true);
+            collectCoverage(runTestsForCoverageOnly(settingsContext.timeoutPerTest));
+            showErrors();
+            return Status::OK;
+        }
         init(withCoverage);
-        runTests(withCoverage, settingsContext.timeoutPerTest);
+        runTests(withCoverage, settingsContext.timeoutPerTest, !sanitizeFailedTestsOnly);
+        if (withCoverage) {
+            collectCoverage(
+                CollectionUtils::filterToVector(testsToLaunch, [this](const UnitTest &testToLaunch) {
+                    return testResultMap[testToLaunch.testFilePath][testToLaunch.testname]
+                               .status() != testsgen::TEST_INTERRUPTED;
+                }));
+        }
+        if (sanitizeFailedTestsOnly) {
+            // coverage is already collected, so the rerun doesn't affect it
+            rerunFailedTestsWithSanitizers(withCoverage, settingsContext.timeoutPerTest);
+        }
         if (withCoverage) {
-            collectCoverage();
             StatsUtils::TestsExecutionStatsFileMap testsExecutionStats(projectContext, testResultMap, coverageMap);
             printer::CSVPrinter printer = testsExecutionStats.toCSV();
             FileSystemUtils::writeToFile(Paths::getExecutionStatsCSVPath(projectContext), printer.getStream().str());
@@ -82,29 +102,33 @@ nlohmann::json const &CoverageAndResultsGenerator::getTotals() {
     return totals;
 }
 
-void CoverageAndResultsGenerator::collectCoverage() {
+void CoverageAndResultsGenerator::collectCoverage(const std::vector<UnitTest> &testsToCover) {
     MEASURE_FUNCTION_EXECUTION_TIME
     if (testsToLaunch.empty()) {
         return;
     }
-    std::vector<ShellExecTask> coverageCommands = coverageTool->getCoverageCommands(
-        CollectionUtils::filterToVector(testsToLaunch, [this](const UnitTest &testToLaunch) {
-            return testResultMap[testToLaunch.testFilePath][testToLaunch.testname].status() !=
-                   testsgen::TEST_INTERRUPTED;
-        }));
+    std::vector<ShellExecTask> coverageCommands = coverageTool->getCoverageCommands(testsToCover);
     if (coverageCommands.empty()) {
         return;
     }
-    ExecUtils::doWorkWithProgress(
-        coverageCommands, coverageAndResultsWriter, "Collecting coverage",
-        [this](ShellExecTask &task) {
-            auto [out, status, path] = task.run();
-            if (status != 0) {
-                exceptions.emplace_back(
-                    StringUtils::stringFormat("Command: %s\nOutput: %s", task.toString(), out),
-                    path.value());
-            }
-        });
+    std::mutex exceptionsMutex;
+    auto runCommand = [this, &exceptionsMutex](ShellExecTask &task) {
+        auto [out, status, path] = task.run();
+        if (status != 0) {
+            std::lock_guard<std::mutex> lock(exceptionsMutex);
+            exceptions.emplace_back(
+                StringUtils::stringFormat("Command: %s\nOutput: %s", task.toString(), out),
+                path.value());
+        }
+    };
+    size_t concurrency = coverageTool->getCoverageCommandsConcurrency();
+    if (concurrency > 1) {
+        ExecUtils::doWorkWithProgressInParallel(coverageCommands, coverageAndResultsWriter,
+                                                "Collecting coverage", concurrency, runCommand);
+    } else {
+        ExecUtils::doWorkWithProgress(coverageCommands, coverageAndResultsWriter,
+                                      "Collecting coverage", runCommand);
+    }
 
     LOG_S(DEBUG) << "All coverage commands were executed";
 
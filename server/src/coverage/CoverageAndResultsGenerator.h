@@ -25,11 +25,19 @@ public:
     const nlohmann::json &getTotals();
 private:
     CoverageAndResultsWriter* coverageAndResultsWriter = nullptr;
+    /**
+     * Tests are run without sanitizers and only those which don't pass are rerun with them.
+     */
+    const bool sanitizeFailedTestsOnly;
+    /**
+     * Test binaries are run once and only coverage is collected.
+     */
+    const bool coverageOnly;
 
     Coverage::CoverageMap coverageMap{};
     nlohmann::json totals{};
 
-    void collectCoverage();
+    void collectCoverage(const std::vector<UnitTest> &testsToCover);
     void showErrors() const;
 };
 
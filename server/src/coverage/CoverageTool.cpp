@@ -12,6 +12,10 @@ CoverageTool::CoverageTool(utbot::ProjectContext projectContext, ProgressWriter
         projectContext(std::move(projectContext)), progressWriter(progressWriter) {
 }
 
+size_t CoverageTool::getCoverageCommandsConcurrency() const {
+    return 1;
+}
+
 std::unique_ptr<CoverageTool> getCoverageTool(const std::string &compileCommandsJsonPath,
                                               utbot::ProjectContext projectContext,
                                               ProgressWriter const *progressWriter) {
@@ -31,9 +35,16 @@ std::unique_ptr<CoverageTool> getCoverageTool(const std::string &compileCommands
 }
 
 std::string CoverageTool::getGTestFlags(const UnitTest &unitTest) const {
+    if (unitTest.testname.empty()) {
+        return StringUtils::stringFormat("\"--gtest_filter=%s.*\"", unitTest.suitename);
+    }
     std::string gtestFilterFlag = StringUtils::stringFormat("\"--gtest_filter=*.%s\"", unitTest.testname);
     std::string gtestOutputFlag = StringUtils::stringFormat("\"--gtest_output=json:%s\"",
                                                             Paths::getGTestResultsJsonPath(projectContext));
     std::vector<std::string> gtestFlagsList = { gtestFilterFlag, gtestOutputFlag };
     return StringUtils::joinWith(gtestFlagsList, " ");
 }
+
+std::vector<std::string> CoverageTool::getSanitizerEnv(bool withSanitizers) {
+    return { StringUtils::stringFormat("UTBOT_SANITIZE=%d", withSanitizers ? 1 : 0) };
+}
@@ -22,17 +22,34 @@ protected:
     ProgressWriter const *progressWriter;
     const utbot::ProjectContext projectContext;
 
+    /**
+     * Flags which run a single test and write its result. For a whole suite the flags
+     * only select its tests.
+     */
     [[nodiscard]] std::string getGTestFlags(const UnitTest &unitTest) const;
 
+    /**
+     * Makefile variables which select plain or sanitized build of tests.
+     */
+    [[nodiscard]] static std::vector<std::string> getSanitizerEnv(bool withSanitizers);
+
 public:
     CoverageTool(utbot::ProjectContext projectContext, ProgressWriter const *progressWriter);
 
     [[nodiscard]] virtual std::vector<BuildRunCommand>
-    getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch, bool withCoverage) = 0;
+    getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch,
+                        bool withCoverage,
+                        bool withSanitizers) = 0;
 
     [[nodiscard]] virtual std::vector<ShellExecTask>
     getCoverageCommands(const std::vector<UnitTest> &testsToLaunch) = 0;
 
+    /**
+     * Number of coverage commands that may be run simultaneously. If it is 1,
+     * commands depend on each other and are run in the returned order.
+     */
+    [[nodiscard]] virtual size_t getCoverageCommandsConcurrency() const;
+
     [[nodiscard]] virtual Coverage::CoverageMap getCoverageInfo() const = 0;
 
     /**
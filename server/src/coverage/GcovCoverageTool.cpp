@@ -8,7 +8,6 @@
 #include "utils/CollectionUtils.h"
 #include "utils/ExecUtils.h"
 #include "utils/FileSystemUtils.h"
-#include "utils/JsonUtils.h"
 #include "utils/LogUtils.h"
 #include "utils/MakefileUtils.h"
 #include "utils/StringUtils.h"
@@ -17,18 +16,28 @@
 #include "loguru.h"
 #include "json.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <utility>
 
 using Coverage::CoverageMap;
 using Coverage::FileCoverage;
 
+static const std::string GCOV_JSON_EXTENSION = ".gcov.json";
+
 GcovCoverageTool::GcovCoverageTool(utbot::ProjectContext projectContext,
                                    ProgressWriter const *progressWriter)
     : CoverageTool(std::move(projectContext), progressWriter) {
 }
 
 std::vector<BuildRunCommand>
-GcovCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch, bool withCoverage) {
+GcovCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch,
+                                      bool withCoverage,
+                                      bool withSanitizers) {
     ExecUtils::throwIfCancelled();
 
     std::vector<BuildRunCommand> result;
@@ -39,44 +48,65 @@ GcovCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch
                 projectContext,
                 Paths::testPathToSourcePath(projectContext, testToLaunch.testFilePath));
             auto gtestFlags = getGTestFlags(testToLaunch);
+            auto env = getSanitizerEnv(withSanitizers);
             auto buildCommand =
-                MakefileUtils::MakefileCommand(projectContext, makefile, "build", gtestFlags);
+                MakefileUtils::MakefileCommand(projectContext, makefile, "build", gtestFlags, env);
             auto runCommand =
-                MakefileUtils::MakefileCommand(projectContext, makefile, "run", gtestFlags);
+                MakefileUtils::MakefileCommand(projectContext, makefile, "run", gtestFlags, env);
             result.push_back({ testToLaunch, buildCommand, runCommand });
         });
     return result;
 }
 
-std::vector <std::string> GcovCoverageTool::getGcovArguments(bool jsonFormat) const {
-    fs::path gcdaDirPath = Paths::getGcdaDirPath(projectContext);
-    std::vector <fs::path> gcdaFiles = getGcdaFiles();
-    if (gcdaFiles.empty()) {
-        LOG_S(WARNING) << "There are no .gcda files in directory: " << gcdaDirPath;
-        return {};
-    }
-    std::vector<std::string> gcovArgs = {"gcov"};
+std::vector<std::string> GcovCoverageTool::getGcovArguments(const std::vector<fs::path> &gcdaFiles,
+                                                            bool jsonFormat) {
+    std::vector<std::string> gcovArgs;
     if (jsonFormat) {
         gcovArgs.emplace_back("--json-format");
+    } else {
+        // only the summary printed to stdout is needed
+        gcovArgs.emplace_back("--no-output");
     }
-    for (const auto& file : getGcdaFiles()) {
+    for (const auto &file : gcdaFiles) {
         gcovArgs.emplace_back(file.string());
     }
     return gcovArgs;
 }
 
+std::vector<std::vector<fs::path>> GcovCoverageTool::getGcdaFilesByObjectDir() const {
+    std::vector<fs::path> gcdaFiles = getGcdaFiles();
+    if (gcdaFiles.empty()) {
+        LOG_S(WARNING) << "There are no .gcda files in directories: "
+                       << StringUtils::joinWith(Paths::getGcdaDirPaths(projectContext), " ");
+        return {};
+    }
+    std::map<fs::path, std::vector<fs::path>> gcdaFilesByObjectDir;
+    for (const auto &gcdaFile : gcdaFiles) {
+        gcdaFilesByObjectDir[gcdaFile.parent_path()].push_back(gcdaFile);
+    }
+    std::vector<std::vector<fs::path>> result;
+    for (auto &[objectDir, objectDirGcdaFiles] : gcdaFilesByObjectDir) {
+        result.push_back(std::move(objectDirGcdaFiles));
+    }
+    return result;
+}
+
 std::vector<ShellExecTask> GcovCoverageTool::getCoverageCommands(const std::vector<UnitTest> &testsToLaunch) {
     MEASURE_FUNCTION_EXECUTION_TIME
     fs::path gcovDir = Paths::getGccCoverageDir(projectContext);
-    auto gcovArgs = getGcovArguments(true);
-    if (gcovArgs.empty()) {
-        return {};
+    std::vector<ShellExecTask> tasks;
+    for (const auto &objectDirGcdaFiles : getGcdaFilesByObjectDir()) {
+        // object directories may contain files with the same names, so outputs are separated
+        fs::path outputDir = gcovDir / std::to_string(tasks.size());
+        fs::create_directories(outputDir);
+        tasks.push_back(ShellExecTask::getShellCommandTask(
+            "gcov", getGcovArguments(objectDirGcdaFiles, true), outputDir.string()));
     }
-    fs::create_directories(gcovDir.string());
-    return {
-        ShellExecTask::getShellCommandTask("gcov", gcovArgs, gcovDir.string()),
-        ShellExecTask::getShellCommandTask("gunzip", {"-f", "-r", gcovDir.string()})
-    };
+    return tasks;
+}
+
+size_t GcovCoverageTool::getCoverageCommandsConcurrency() const {
+    return std::max(1u, std::thread::hardware_concurrency());
 }
 
 static void addLine(uint32_t lineNumber, bool covered, FileCoverage &fileCoverage) {
@@ -88,22 +118,176 @@ static void addLine(uint32_t lineNumber, bool covered, FileCoverage &fileCoverag
     }
 }
 
-static void setLineNumbers(const nlohmann::json &file, FileCoverage &fileCoverage) {
-    for (const nlohmann::json &line : file.at("lines")) {
-        uint32_t  lineNumber = line.at("line_number").get<int>();
-        bool covered = line.at("count").get<int>() > 0;
-        addLine(lineNumber, covered, fileCoverage);
-    }
-}
+namespace {
+    /**
+     * SAX handler for JSON intermediate format of gcov:
+     * {"files": [{"file": ..., "lines": [...], "functions": [...]}, ...], ...}.
+     * Lines of a source file are collected while its object is parsed and are added to
+     * the coverage map when the object ends, so a document is never kept in memory.
+     */
+    class GcovJsonHandler {
+    public:
+        using json = nlohmann::json;
 
-static void setFunctionBorders(const nlohmann::json &file, FileCoverage &fileCoverage) {
-    for (const nlohmann::json &function : file.at("functions")) {
-        uint32_t startLine = function.at("start_line");
-        uint32_t endLine = function.at("end_line");
-        bool covered = function.at("execution_count").get<int>() > 0;
-        addLine(startLine, covered, fileCoverage);
-        addLine(endLine, covered, fileCoverage);
-    }
+        GcovJsonHandler(CoverageMap &coverageMap, std::mutex &coverageMapMutex)
+            : coverageMap(coverageMap), coverageMapMutex(coverageMapMutex) {
+        }
+
+        bool start_object(size_t) {
+            ++depth;
+            if (depth == FILE_DEPTH && inFiles) {
+                filePath.clear();
+                lines.clear();
+            } else if (depth == ENTRY_DEPTH) {
+                entry = {};
+            }
+            return true;
+        }
+
+        bool end_object() {
+            if (depth == ENTRY_DEPTH) {
+                addEntry();
+            } else if (depth == FILE_DEPTH && inFiles) {
+                addFile();
+            }
+            --depth;
+            return true;
+        }
+
+        bool start_array(size_t) {
+            ++depth;
+            if (depth == FILE_DEPTH - 1) {
+                inFiles = lastKey == "files";
+            } else if (depth == ENTRY_DEPTH - 1 && inFiles) {
+                section = lastKey == "lines"       ? Section::LINES
+                          : lastKey == "functions" ? Section::FUNCTIONS
+                                                   : Section::OTHER;
+            }
+            return true;
+        }
+
+        bool end_array() {
+            if (depth == ENTRY_DEPTH - 1) {
+                section = Section::OTHER;
+            } else if (depth == FILE_DEPTH - 1) {
+                inFiles = false;
+            }
+            --depth;
+            return true;
+        }
+
+        bool key(json::string_t &key) {
+            lastKey = key;
+            return true;
+        }
+
+        bool string(json::string_t &value) {
+            if (depth == FILE_DEPTH && inFiles && lastKey == "file") {
+                filePath = value;
+            }
+            return true;
+        }
+
+        bool number_unsigned(json::number_unsigned_t value) {
+            if (depth == ENTRY_DEPTH && section != Section::OTHER) {
+                setEntryValue(value);
+            }
+            return true;
+        }
+
+        bool number_integer(json::number_integer_t value) {
+            if (depth == ENTRY_DEPTH && section != Section::OTHER) {
+                setEntryValue(static_cast<uint64_t>(std::max<json::number_integer_t>(value, 0)));
+            }
+            return true;
+        }
+
+        bool number_float(json::number_float_t, const json::string_t &) {
+            return true;
+        }
+
+        bool boolean(bool) {
+            return true;
+        }
+
+        bool null() {
+            return true;
+        }
+
+        template <typename Binary>
+        bool binary(Binary &) {
+            return true;
+        }
+
+        template <typename Exception>
+        bool parse_error(size_t position, const std::string &, const Exception &e) {
+            error = e.what();
+            return false;
+        }
+
+        std::string error;
+
+    private:
+        static const int FILE_DEPTH = 3;
+        static const int ENTRY_DEPTH = 5;
+
+        enum class Section { LINES, FUNCTIONS, OTHER };
+
+        struct Entry {
+            uint64_t lineNumber = 0;
+            uint64_t count = 0;
+            uint64_t startLine = 0;
+            uint64_t endLine = 0;
+            uint64_t executionCount = 0;
+        };
+
+        CoverageMap &coverageMap;
+        std::mutex &coverageMapMutex;
+        int depth = 0;
+        bool inFiles = false;
+        Section section = Section::OTHER;
+        std::string lastKey;
+        std::string filePath;
+        Entry entry;
+        // line number and whether it is covered
+        std::vector<std::pair<uint32_t, bool>> lines;
+
+        void setEntryValue(uint64_t value) {
+            if (lastKey == "line_number") {
+                entry.lineNumber = value;
+            } else if (lastKey == "count") {
+                entry.count = value;
+            } else if (lastKey == "start_line") {
+                entry.startLine = value;
+            } else if (lastKey == "end_line") {
+                entry.endLine = value;
+            } else if (lastKey == "execution_count") {
+                entry.executionCount = value;
+            }
+        }
+
+        void addEntry() {
+            if (section == Section::LINES) {
+                lines.emplace_back(entry.lineNumber, entry.count > 0);
+            } else if (section == Section::FUNCTIONS) {
+                bool covered = entry.executionCount > 0;
+                lines.emplace_back(entry.startLine, covered);
+                lines.emplace_back(entry.endLine, covered);
+            }
+        }
+
+        void addFile() {
+            fs::path path(filePath);
+            if (Paths::isGtest(path)) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(coverageMapMutex);
+            FileCoverage &fileCoverage = coverageMap[path];
+            for (const auto &[lineNumber, covered] : lines) {
+                addLine(lineNumber, covered, fileCoverage);
+            }
+        }
+    };
 }
 
 CoverageMap GcovCoverageTool::getCoverageInfo() const {
@@ -119,45 +303,67 @@ CoverageMap GcovCoverageTool::getCoverageInfo() const {
     }
     LOG_S(INFO) << "Reading coverage files";
 
-    ExecUtils::doWorkWithProgress(
-        FileSystemUtils::DirectoryIterator(covJsonDirPath), progressWriter,
-        "Reading coverage files", [&coverageMap](auto const &entry) {
-            auto jsonPath = entry.path();
-            auto coverageJson = JsonUtils::getJsonFromFile(jsonPath);
-            for (const nlohmann::json &jsonFile : coverageJson.at("files")) {
-                fs::path filePath(std::filesystem::path(jsonFile.at("file")));
-                if (Paths::isGtest(filePath)) {
-                    continue;
-                }
-                setLineNumbers(jsonFile, coverageMap[filePath]);
-                setFunctionBorders(jsonFile, coverageMap[filePath]);
+    // gcov writes compressed files, only the ones it has written are decompressed
+    std::set<fs::path> jsonPaths;
+    std::map<fs::path, std::vector<std::string>> archivesByDir;
+    for (const auto &entry : fs::recursive_directory_iterator(covJsonDirPath)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        const fs::path &path = entry.path();
+        if (StringUtils::endsWith(path.filename().string(), GCOV_JSON_EXTENSION + ".gz")) {
+            archivesByDir[path.parent_path()].push_back(path.filename().string());
+            jsonPaths.insert(path.parent_path() / path.stem());
+        } else if (StringUtils::endsWith(path.filename().string(), GCOV_JSON_EXTENSION)) {
+            jsonPaths.insert(path);
+        }
+    }
+    if (jsonPaths.empty()) {
+        LOG_S(WARNING) << "gcov has not written any coverage files to " << covJsonDirPath;
+        return coverageMap;
+    }
+    std::vector<ShellExecTask> gunzipTasks;
+    for (auto &[dir, archives] : archivesByDir) {
+        archives.insert(archives.begin(), "-f");
+        gunzipTasks.push_back(ShellExecTask::getShellCommandTask("gunzip", archives, dir.string()));
+    }
+    ExecUtils::doWorkWithProgressInParallel(
+        gunzipTasks, progressWriter, "Decompressing coverage files",
+        getCoverageCommandsConcurrency(), [](ShellExecTask &task) {
+            auto [out, status, path] = task.run();
+            if (status != 0) {
+                throw CoverageGenerationException(
+                    StringUtils::stringFormat("Couldn't decompress coverage files. Command: %s\nOutput: %s",
+                                              task.toString(), out));
+            }
+        });
+
+    std::mutex coverageMapMutex;
+    ExecUtils::doWorkWithProgressInParallel(
+        jsonPaths, progressWriter, "Reading coverage files", getCoverageCommandsConcurrency(),
+        [&coverageMap, &coverageMapMutex](const fs::path &jsonPath) {
+            std::ifstream stream(jsonPath);
+            GcovJsonHandler handler(coverageMap, coverageMapMutex);
+            if (!nlohmann::json::sax_parse(stream, &handler)) {
+                throw CoverageGenerationException("Couldn't parse coverage file " +
+                                                  jsonPath.string() + ": " + handler.error);
             }
         });
     return coverageMap;
 }
 
-nlohmann::json GcovCoverageTool::getTotals() const {
-    MEASURE_FUNCTION_EXECUTION_TIME
-    fs::path gcovDir = Paths::getGccCoverageDir(projectContext);
-    std::vector <std::string> gcovArgs = getGcovArguments(false);
-    auto task = ShellExecTask::getShellCommandTask("gcov", gcovArgs, gcovDir.string());
-    auto [out, status, path] = task.run();
-    if (status != 0) {
-        LOG_S(ERROR) << "gcov exit code: " << status << ". See more info in logs: " << path.value();
-        return {};
-    }
-    /**
-     * Output has the following structure:
-     * File 'file.c'
-     * lines executed:100.00% of 2
-     * creating file '...'
-     *
-     * The code below retrieves the percentages
-     * for project source files.
-     */
+/**
+ * Output has the following structure:
+ * File 'file.c'
+ * Lines executed:100.00% of 2
+ *
+ * The code below retrieves the numbers of lines
+ * for project source files.
+ */
+static std::pair<uint32_t, uint32_t> parseGcovTotals(const std::string &out) {
     uint32_t totalCovered = 0, totalLines = 0;
     std::vector <std::string> gcovOutput = StringUtils::split(out.c_str(), '\n');
-    for (size_t i = 0; i < gcovOutput.size(); i++) {
+    for (size_t i = 0; i + 1 < gcovOutput.size(); i++) {
         const auto& line = gcovOutput[i];
         if (StringUtils::startsWith(line, "File ")) {
             std::string filename = line.substr(6, (int)line.size() - 7);
@@ -172,6 +378,39 @@ nlohmann::json GcovCoverageTool::getTotals() const {
             }
         }
     }
+    return { totalCovered, totalLines };
+}
+
+nlohmann::json GcovCoverageTool::getTotals() const {
+    MEASURE_FUNCTION_EXECUTION_TIME
+    fs::path gcovDir = Paths::getGccCoverageDir(projectContext);
+    auto gcdaFilesByObjectDir = getGcdaFilesByObjectDir();
+    if (gcdaFilesByObjectDir.empty()) {
+        return {};
+    }
+    std::mutex totalsMutex;
+    uint32_t totalCovered = 0, totalLines = 0;
+    bool failed = false;
+    ExecUtils::doWorkWithProgressInParallel(
+        gcdaFilesByObjectDir, progressWriter, "Computing coverage totals",
+        getCoverageCommandsConcurrency(), [&](const std::vector<fs::path> &gcdaFiles) {
+            auto task = ShellExecTask::getShellCommandTask(
+                "gcov", getGcovArguments(gcdaFiles, false), gcovDir.string());
+            auto [out, status, path] = task.run();
+            std::lock_guard<std::mutex> lock(totalsMutex);
+            if (status != 0) {
+                LOG_S(ERROR) << "gcov exit code: " << status
+                             << ". See more info in logs: " << path.value();
+                failed = true;
+                return;
+            }
+            auto [covered, lines] = parseGcovTotals(out);
+            totalCovered += covered;
+            totalLines += lines;
+        });
+    if (failed) {
+        return {};
+    }
     return { {
         "lines", {
             { "count", totalLines },
@@ -191,13 +430,15 @@ void GcovCoverageTool::cleanCoverage() const {
 }
 std::vector<fs::path> GcovCoverageTool::getGcdaFiles() const {
     std::vector<fs::path> result;
-    fs::path gcdaDirPath = Paths::getGcdaDirPath(projectContext);
-    if (!fs::exists(gcdaDirPath)) {
-        return {};
-    }
-    for (const auto &entry : fs::recursive_directory_iterator(gcdaDirPath)) {
-        if (entry.is_regular_file() && entry.path().extension() == ".gcda") {
-            result.emplace_back(entry.path());
+    // plain and sanitized objects are kept apart, each of them may have been run
+    for (const fs::path &gcdaDirPath : Paths::getGcdaDirPaths(projectContext)) {
+        if (!fs::exists(gcdaDirPath)) {
+            continue;
+        }
+        for (const auto &entry : fs::recursive_directory_iterator(gcdaDirPath)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".gcda") {
+                result.emplace_back(entry.path());
+            }
         }
     }
     return result;
@@ -10,12 +10,17 @@ public:
     GcovCoverageTool(utbot::ProjectContext projectContext, ProgressWriter const *progressWriter);
 
     std::vector<BuildRunCommand> getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch,
-                                                     bool withCoverage) override;
-
-    std::vector <std::string> getGcovArguments(bool jsonFormat) const;
+                                                     bool withCoverage,
+                                                     bool withSanitizers) override;
 
+    /**
+     * One gcov invocation per object directory. Every invocation writes its JSON files
+     * to a separate directory, so they are independent.
+     */
     std::vector<ShellExecTask> getCoverageCommands(const std::vector<UnitTest> &testsToLaunch) override;
 
+    [[nodiscard]] size_t getCoverageCommandsConcurrency() const override;
+
     [[nodiscard]] Coverage::CoverageMap getCoverageInfo() const override;
 
     [[nodiscard]] nlohmann::json getTotals() const override;
@@ -24,6 +29,14 @@ public:
 
 private:
     std::vector<fs::path> getGcdaFiles() const;
+
+    /**
+     * gcda files grouped by their directory, so gcov can be run for every group separately.
+     */
+    std::vector<std::vector<fs::path>> getGcdaFilesByObjectDir() const;
+
+    static std::vector<std::string> getGcovArguments(const std::vector<fs::path> &gcdaFiles,
+                                                     bool jsonFormat);
 };
 
 
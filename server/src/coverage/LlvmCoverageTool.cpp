@@ -26,17 +26,20 @@ LlvmCoverageTool::LlvmCoverageTool(utbot::ProjectContext projectContext,
 }
 
 std::vector<BuildRunCommand>
-LlvmCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch, bool withCoverage) {
+LlvmCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch,
+                                      bool withCoverage,
+                                      bool withSanitizers) {
+    binariesWithSanitizers &= withSanitizers;
     return CollectionUtils::transform(testsToLaunch, [&](UnitTest const &testToLaunch) {
         fs::path sourcePath =
             Paths::testPathToSourcePath(projectContext, testToLaunch.testFilePath);
         auto makefilePath = Paths::getMakefilePathFromSourceFilePath(projectContext, sourcePath);
-        auto testName = testToLaunch.testname;
         auto gtestFlags = getGTestFlags(testToLaunch);
-        std::vector<std::string> profileEnv;
+        std::vector<std::string> profileEnv = getSanitizerEnv(withSanitizers);
         if (withCoverage) {
-            auto profrawFilePath = Paths::getProfrawFilePath(projectContext, testName);
-            profileEnv = { StringUtils::stringFormat("LLVM_PROFILE_FILE=%s", profrawFilePath) };
+            auto profrawFilePath = getProfrawFilePath(testToLaunch);
+            profileEnv.push_back(
+                StringUtils::stringFormat("LLVM_PROFILE_FILE=%s", profrawFilePath));
         }
         auto buildCommand = MakefileUtils::MakefileCommand(projectContext, makefilePath, "build",
                                                            gtestFlags, profileEnv);
@@ -46,13 +49,21 @@ LlvmCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch
     });
 }
 
+fs::path LlvmCoverageTool::getProfrawFilePath(const UnitTest &unitTest) const {
+    if (unitTest.testname.empty()) {
+        return Paths::getProfrawFilePath(
+            projectContext, unitTest.testFilePath.stem().string() + "_" + unitTest.suitename);
+    }
+    return Paths::getProfrawFilePath(projectContext, unitTest.testname);
+}
+
 std::vector<ShellExecTask>
 LlvmCoverageTool::getCoverageCommands(const std::vector<UnitTest> &testsToLaunch) {
     MEASURE_FUNCTION_EXECUTION_TIME
     std::vector<std::string> coverageCommands;
     auto profrawFilePaths =
         CollectionUtils::transform(testsToLaunch, [&](UnitTest const &testToLaunch) {
-            return Paths::getProfrawFilePath(projectContext, testToLaunch.testname);
+            return getProfrawFilePath(testToLaunch);
         });
     bool allEmpty = true;
     for (fs::path const &profrawFilePath : profrawFilePaths) {
@@ -75,7 +86,8 @@ LlvmCoverageTool::getCoverageCommands(const std::vector<UnitTest> &testsToLaunch
             fs::path sourcePath = Paths::testPathToSourcePath(projectContext, testFilePath);
             fs::path makefile =
                 Paths::getMakefilePathFromSourceFilePath(projectContext, sourcePath);
-            auto makefileCommand = MakefileUtils::MakefileCommand(projectContext, makefile, "bin");
+            auto makefileCommand = MakefileUtils::MakefileCommand(
+                projectContext, makefile, "bin", "", getSanitizerEnv(binariesWithSanitizers));
             auto res = makefileCommand.run();
             if (res.status == 0) {
                 if (res.output.empty()) {
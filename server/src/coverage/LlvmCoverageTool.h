@@ -9,7 +9,8 @@ public:
     LlvmCoverageTool(utbot::ProjectContext projectContext, ProgressWriter const *progressWriter);
 
     std::vector<BuildRunCommand> getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch,
-                                                     bool withCoverage) override;
+                                                     bool withCoverage,
+                                                     bool withSanitizers) override;
 
     std::vector<ShellExecTask> getCoverageCommands(const std::vector<UnitTest> &testFilePath) override;
 
@@ -17,6 +18,17 @@ public:
     [[nodiscard]] nlohmann::json getTotals() const override;
     void cleanCoverage() const override;
 private:
+    /**
+     * Whether every launched test has a sanitized binary. False once a plain run was built,
+     * because a sanitized rerun rebuilds only the failed tests.
+     */
+    bool binariesWithSanitizers = true;
+
+    /**
+     * Profile of a test, or of the test file if it stands for a whole suite.
+     */
+    fs::path getProfrawFilePath(const UnitTest &unitTest) const;
+
     void countLineCoverage(Coverage::CoverageMap& coverageMap, const std::string& filename) const;
     void checkLineForPartial(Coverage::FileCoverage::SourceLine line, Coverage::FileCoverage& fileCoverage) const;
 };
@@ -3,12 +3,16 @@
 #include "Paths.h"
 #include "TimeExecStatistics.h"
 #include "utils/FileSystemUtils.h"
+#include "utils/HashUtils.h"
 #include "utils/JsonUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/stats/TestsExecutionStats.h"
 
 #include "loguru.h"
 
+#include <fstream>
+#include <map>
+
 using grpc::ServerWriter;
 using grpc::Status;
 
@@ -25,7 +29,7 @@ TestRunner::TestRunner(utbot::ProjectContext projectContext,
 
 TestRunner::TestRunner(
     const testsgen::CoverageAndResultsRequest *coverageAndResultsRequest,
-    grpc::ServerWriter<testsgen::CoverageAndResultsResponse> *coverageAndResultsWriter,
+    grpc::ServerWriterInterface<testsgen::CoverageAndResultsResponse> *coverageAndResultsWriter,
     std::string testFilename,
     std::string testSuite,
     std::string testName)
@@ -37,6 +41,41 @@ TestRunner::TestRunner(
     writer = ServerCoverageAndResultsWriter(coverageAndResultsWriter);
 }
 
+std::optional<std::vector<UnitTest>>
+TestRunner::getTestsFromManifest(const fs::path &testFilePath) const {
+    fs::path sourcePath = Paths::testPathToSourcePath(projectContext, testFilePath);
+    fs::path manifestPath = Paths::getTestManifestPath(projectContext, sourcePath);
+    if (!fs::exists(manifestPath) || !fs::exists(testFilePath)) {
+        return std::nullopt;
+    }
+    std::ifstream testFileStream(testFilePath.string(), std::ios::binary);
+    std::string code(std::istreambuf_iterator<char>(testFileStream), {});
+    try {
+        auto manifest = JsonUtils::getJsonFromFile(manifestPath);
+        if (manifest.at("hash").get<std::string>() != HashUtils::contentHash(code)) {
+            LOG_S(DEBUG) << "Test file was modified after generation: " << testFilePath;
+            return std::nullopt;
+        }
+        std::vector<UnitTest> result;
+        for (const auto &test : manifest.at("tests")) {
+            result.push_back(UnitTest{ testFilePath, test.at("suite").get<std::string>(),
+                                       test.at("name").get<std::string>() });
+        }
+        return result;
+    } catch (const nlohmann::json::exception &e) {
+        LOG_S(WARNING) << "Failed to read test manifest " << manifestPath << ": " << e.what();
+        return std::nullopt;
+    }
+}
+
+std::vector<UnitTest> TestRunner::getTestsForFile(const fs::path &makefile,
+                                                  const fs::path &testFilePath) {
+    if (auto tests = getTestsFromManifest(testFilePath)) {
+        return std::move(tests.value());
+    }
+    return getTestsFromMakefile(makefile, testFilePath);
+}
+
 std::vector<UnitTest> TestRunner::getTestsFromMakefile(const fs::path &makefile,
                                                        const fs::path &testFilePath) {
     auto cmdGetAllTests = MakefileUtils::MakefileCommand(projectContext, makefile, "run", "--gtest_list_tests", {"GTEST_FILTER=*"});
@@ -94,7 +133,7 @@ std::vector<UnitTest> TestRunner::getTestsToLaunch() {
                             Paths::getMakefilePathFromSourceFilePath(projectContext, sourcePath);
                         if (fs::exists(makefile)) {
                             try {
-                                auto tests = getTestsFromMakefile(makefile, testFilePath);
+                                auto tests = getTestsForFile(makefile, testFilePath);
                                 CollectionUtils::extend(result, tests);
                             } catch (ExecutionProcessException const &e) {
                                 exceptions.push_back(e);
@@ -120,18 +159,103 @@ std::vector<UnitTest> TestRunner::getTestsToLaunch() {
         //for file
         fs::path sourcePath = Paths::testPathToSourcePath(projectContext, testFilePath.value());
         fs::path makefile = Paths::getMakefilePathFromSourceFilePath(projectContext, sourcePath);
-        return getTestsFromMakefile(makefile, testFilePath.value());
+        return getTestsForFile(makefile, testFilePath.value());
     }
     //for single test
     return { UnitTest{ testFilePath.value(), testSuite, testName } };
 }
 
-grpc::Status TestRunner::runTests(bool withCoverage, const std::optional<std::chrono::seconds> &testTimeout) {
+grpc::Status TestRunner::runTests(bool withCoverage,
+                                  const std::optional<std::chrono::seconds> &testTimeout,
+                                  bool withSanitizers) {
+    MEASURE_FUNCTION_EXECUTION_TIME
+    ExecUtils::throwIfCancelled();
+
+    const auto buildRunCommands =
+        coverageTool->getBuildRunCommands(testsToLaunch, withCoverage, withSanitizers);
+    runBuildRunCommands(buildRunCommands, "Running tests", testTimeout);
+    LOG_S(DEBUG) << "All run commands were executed";
+    return Status::OK;
+}
+
+void TestRunner::rerunFailedTestsWithSanitizers(
+    bool withCoverage,
+    const std::optional<std::chrono::seconds> &testTimeout) {
     MEASURE_FUNCTION_EXECUTION_TIME
     ExecUtils::throwIfCancelled();
 
-    const auto buildRunCommands = coverageTool->getBuildRunCommands(testsToLaunch, withCoverage);
-    ExecUtils::doWorkWithProgress(buildRunCommands, progressWriter, "Running tests",
+    auto failedTests =
+        CollectionUtils::filterToVector(testsToLaunch, [this](const UnitTest &testToLaunch) {
+            return testResultMap[testToLaunch.testFilePath][testToLaunch.testname].status() !=
+                   testsgen::TEST_PASSED;
+        });
+    if (failedTests.empty()) {
+        return;
+    }
+    LOG_S(INFO) << StringUtils::stringFormat("Rerunning %d failed tests with sanitizers",
+                                             failedTests.size());
+    const auto buildRunCommands =
+        coverageTool->getBuildRunCommands(failedTests, withCoverage, true);
+    runBuildRunCommands(buildRunCommands, "Rerunning failed tests with sanitizers", testTimeout);
+}
+
+std::vector<UnitTest>
+TestRunner::runTestsForCoverageOnly(const std::optional<std::chrono::seconds> &testTimeout) {
+    MEASURE_FUNCTION_EXECUTION_TIME
+    ExecUtils::throwIfCancelled();
+
+    // regression tests are expected to pass, so tests of a file share one process, while
+    // error tests are likely to crash it and lose the profile, so they are run one by one
+    std::map<fs::path, std::vector<UnitTest>> regressionTests;
+    std::vector<UnitTest> separateTests;
+    for (const auto &testToLaunch : testsToLaunch) {
+        if (testName.empty() && testToLaunch.suitename == tests::Tests::DEFAULT_SUITE_NAME) {
+            regressionTests[testToLaunch.testFilePath].push_back(testToLaunch);
+        } else {
+            separateTests.push_back(testToLaunch);
+        }
+    }
+    std::vector<UnitTest> suites;
+    for (const auto &[testFilePath, _] : regressionTests) {
+        suites.push_back(UnitTest{ testFilePath, tests::Tests::DEFAULT_SUITE_NAME, "" });
+    }
+
+    std::vector<UnitTest> finishedTests;
+    auto run = [&](BuildRunCommand const &command) {
+        const UnitTest &unitTest = command.unitTest;
+        bool isSuite = unitTest.testname.empty();
+        std::optional<std::chrono::seconds> timeout = testTimeout;
+        if (isSuite && timeout.has_value()) {
+            timeout = timeout.value() *
+                      static_cast<int>(regressionTests[unitTest.testFilePath].size());
+        }
+        auto res = command.runCommand.run(projectContext.buildDir(), true, true, timeout);
+        GTestLogger::log(res.output);
+        if (isSuite && res.status != 0) {
+            LOG_S(WARNING) << "Regression tests didn't pass, they are run one by one: "
+                           << unitTest.testFilePath;
+            CollectionUtils::extend(separateTests, regressionTests[unitTest.testFilePath]);
+        } else if (BaseForkTask::wasInterrupted(res.status)) {
+            LOG_S(WARNING) << StringUtils::stringFormat(
+                "Test %s from %s was interrupted, its coverage is skipped", unitTest.testname,
+                unitTest.testFilePath);
+        } else {
+            finishedTests.push_back(unitTest);
+        }
+        ExecUtils::throwIfCancelled();
+    };
+    ExecUtils::doWorkWithProgress(coverageTool->getBuildRunCommands(suites, true, false),
+                                  progressWriter, "Running regression tests", run);
+    ExecUtils::doWorkWithProgress(coverageTool->getBuildRunCommands(separateTests, true, false),
+                                  progressWriter, "Running tests", run);
+    LOG_S(DEBUG) << "All run commands were executed";
+    return finishedTests;
+}
+
+void TestRunner::runBuildRunCommands(const std::vector<BuildRunCommand> &buildRunCommands,
+                                     const std::string &message,
+                                     const std::optional<std::chrono::seconds> &testTimeout) {
+    ExecUtils::doWorkWithProgress(buildRunCommands, progressWriter, message,
                               [this, testTimeout] (BuildRunCommand const &buildRunCommand) {
                                   auto const &[unitTest, buildCommand, runCommand] =
                                       buildRunCommand;
@@ -148,8 +272,6 @@ grpc::Status TestRunner::runTests(bool withCoverage, const std::optional<std::ch
                                       exceptions.emplace_back(e);
                                   }
                               });
-    LOG_S(DEBUG) << "All run commands were executed";
-    return Status::OK;
 }
 
 void TestRunner::init(bool withCoverage) {
@@ -11,6 +11,7 @@
 #include "streams/coverage/ServerCoverageAndResultsWriter.h"
 #include "Tests.h"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -29,7 +30,24 @@ protected:
     std::vector<ExecutionProcessException> exceptions;
 
     grpc::Status runTests(bool withCoverage,
-                          const std::optional<std::chrono::seconds> &testTimeout);
+                          const std::optional<std::chrono::seconds> &testTimeout,
+                          bool withSanitizers = true);
+
+    /**
+     * Rebuilds tests with sanitizers and reruns those which didn't pass, so failures
+     * of a plain run get the same diagnostics as in a sanitized one.
+     */
+    void rerunFailedTestsWithSanitizers(bool withCoverage,
+                                        const std::optional<std::chrono::seconds> &testTimeout);
+
+    /**
+     * Runs tests for coverage only: without sanitizers and without collecting results.
+     * Regression tests of a file are run in one process with the timeout multiplied by
+     * their number; if any of them doesn't pass, they are rerun one by one like other tests.
+     * @return tests and suites which finished in time and whose coverage may be collected
+     */
+    std::vector<UnitTest>
+    runTestsForCoverageOnly(const std::optional<std::chrono::seconds> &testTimeout);
 
 public:
     TestRunner(utbot::ProjectContext projectContext,
@@ -39,7 +57,7 @@ public:
                ProgressWriter const *progressWriter);
 
     TestRunner(const testsgen::CoverageAndResultsRequest *coverageAndResultsRequest,
-               grpc::ServerWriter<testsgen::CoverageAndResultsResponse> *coverageAndResultsWriter,
+               grpc::ServerWriterInterface<testsgen::CoverageAndResultsResponse> *coverageAndResultsWriter,
                std::string testFilename,
                std::string testSuite,
                std::string testName);
@@ -65,9 +83,21 @@ public:
     static size_t buildTests(const utbot::ProjectContext& projectContext, const tests::TestsMap& tests);
 
 private:
+    /**
+     * Tests of the file listed by the server when the file was printed. Returns nothing if
+     * there is no manifest or the file has been modified since then.
+     */
+    std::optional<std::vector<UnitTest>> getTestsFromManifest(const fs::path &testFilePath) const;
+
+    std::vector<UnitTest> getTestsForFile(const fs::path &makefile, const fs::path &testFilePath);
+
     std::vector<UnitTest> getTestsFromMakefile(const fs::path &makefile,
                                                const fs::path &testFilePath);
 
+    void runBuildRunCommands(const std::vector<BuildRunCommand> &buildRunCommands,
+                             const std::string &message,
+                             const std::optional<std::chrono::seconds> &testTimeout);
+
     testsgen::TestResultObject runTest(const BuildRunCommand &command,
                                        const std::optional<std::chrono::seconds> &testTimeout);
 
@@ -4,6 +4,9 @@
 #include "utils/path/FileSystemPath.h"
 #include <string>
 
+/**
+ * Test with empty name stands for all tests of the suite.
+ */
 struct UnitTest {
     fs::path testFilePath;
     std::string suitename;
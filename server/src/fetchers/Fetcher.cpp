@@ -63,6 +63,15 @@ Fetcher::Fetcher(Options options,
     }
 }
 
+void Fetcher::setFunctionFilter(FunctionFilter filter) {
+    functionFilter = std::move(filter);
+}
+
+bool Fetcher::isFetched(const fs::path &sourceFilePath,
+                        const clang::FunctionDecl *functionDecl) const {
+    return !functionFilter || functionFilter(sourceFilePath, functionDecl);
+}
+
 void Fetcher::fetch() {
     LOG_SCOPE_FUNCTION(DEBUG);
     auto factory = newFrontendActionFactory(&finder, &sourceFileCallbacks);
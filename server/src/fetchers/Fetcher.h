@@ -14,6 +14,7 @@
 #include <clang/Tooling/Tooling.h>
 #include <grpcpp/grpcpp.h>
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -64,6 +65,16 @@ public:
                      const fs::path &compileCommandsJsonPath,
                      bool fetchFunctionBodies);
 
+    /**
+     * Only the functions accepted by the filter and their types are fetched. Line requests
+     * know the function under the cursor before fetching, so the other functions of the
+     * file are not processed at all. Filter gets the main file of the translation unit.
+     */
+    using FunctionFilter =
+        std::function<bool(const fs::path &sourceFilePath, const clang::FunctionDecl *)>;
+
+    void setFunctionFilter(FunctionFilter filter);
+
     void fetch();
 
     void fetchWithProgress(const ProgressWriter *progressWriter,
@@ -87,6 +98,10 @@ public:
 private:
     // For functions
     bool fetchFunctionBodies;
+    FunctionFilter functionFilter;
+
+    [[nodiscard]] bool isFetched(const fs::path &sourceFilePath,
+                                 const clang::FunctionDecl *functionDecl) const;
 
     // For arrays
     std::set<int64_t> returnVariables;
@@ -23,11 +23,13 @@ void FunctionDeclsMatchCallback::run(const MatchFinder::MatchResult &Result) {
     ExecUtils::throwIfCancelled();
     if (const auto *FS = Result.Nodes.getNodeAs<FunctionDecl>(Matchers::FUNCTION_DEF)) {
         ExecUtils::throwIfCancelled();
-
         SourceManager &sourceManager = Result.Context->getSourceManager();
         fs::path sourceFilePath = sourceManager.getFileEntryForID(sourceManager.getMainFileID())
                                       ->tryGetRealPathName()
                                       .str();
+        if (!parent->isFetched(sourceFilePath, FS)) {
+            return;
+        }
 
         std::string methodName = FS->getNameAsString();
         Tests::MethodDescription methodDescription;
@@ -50,6 +50,9 @@ void GlobalVariableUsageMatchCallback::handleUsage(const clang::FunctionDecl *fu
     clang::SourceManager &sourceManager = functionDecl->getASTContext().getSourceManager();
     fs::path sourceFilePath =
         sourceManager.getFileEntryForID(sourceManager.getMainFileID())->tryGetRealPathName().str();
+    if (!parent->isFetched(sourceFilePath, functionDecl)) {
+        return;
+    }
     auto const &[iterator, inserted] =
         usages.emplace(varDecl->getNameAsString(), functionDecl->getNameAsString());
     auto const &usage = *iterator;
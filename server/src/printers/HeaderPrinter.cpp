@@ -14,7 +14,7 @@ namespace printer {
         ss << PrinterUtils::redirectStdin << NL << NL;
         ss << PrinterUtils::fromBytes << NL;
         headerCode += ss.str();
-        FileSystemUtils::writeToFile(testHeaderFilePath, headerCode);
+        FileSystemUtils::writeToFileIfChanged(testHeaderFilePath, headerCode);
     }
 
     void HeaderPrinter::processHeader(const Include &relatedHeader) {
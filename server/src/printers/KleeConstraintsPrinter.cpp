@@ -1,6 +1,7 @@
 #include "KleeConstraintsPrinter.h"
 
 #include "utils/PrinterUtils.h"
+#include "utils/StringUtils.h"
 #include "exceptions/UnImplementedException.h"
 
 #include "loguru.h"
@@ -8,11 +9,49 @@
 using namespace types;
 using printer::KleeConstraintsPrinter;
 
-printer::KleeConstraintsPrinter::KleeConstraintsPrinter(const types::TypesHandler *typesHandler, utbot::Language srcLanguage)
-    : Printer(srcLanguage), typesHandler(typesHandler) {}
+namespace {
+    /*
+     * Control characters can't appear in identifiers or in printed code, so the placeholder
+     * can't clash with anything printed around it. '$' is allowed in identifiers by GCC and Clang.
+     */
+    const std::string VARIABLE_PLACEHOLDER = "\x01utbot_constraints_variable\x01";
+}
+
+printer::KleeConstraintsPrinter::KleeConstraintsPrinter(const types::TypesHandler *typesHandler,
+                                                        utbot::Language srcLanguage,
+                                                        TemplateCache *templateCache)
+    : Printer(srcLanguage), typesHandler(typesHandler), templateCache(templateCache) {}
 
 printer::KleeConstraintsPrinter::Stream
 KleeConstraintsPrinter::genConstraints(const std::string &name, const types::Type& type) {
+    if (templateCache == nullptr) {
+        genConstraintsForVariable(name, type);
+        return ss;
+    }
+    std::string key = getTemplateKey(type);
+    auto it = templateCache->find(key);
+    if (it == templateCache->end()) {
+        std::string printed = ss.str();
+        ss.str("");
+        genConstraintsForVariable(VARIABLE_PLACEHOLDER, type);
+        it = templateCache->emplace(key, ss.str()).first;
+        ss.str("");
+        ss << printed;
+    }
+    std::string constraints = it->second;
+    StringUtils::replaceAll(constraints, VARIABLE_PLACEHOLDER, name);
+    ss << constraints;
+    return ss;
+}
+
+std::string KleeConstraintsPrinter::getTemplateKey(const types::Type &type) const {
+    std::stringstream key;
+    key << type.getHandle() << ':' << type.maybeArray << ':' << static_cast<int>(srcLanguage)
+        << ':' << tabsDepth;
+    return key.str();
+}
+
+void KleeConstraintsPrinter::genConstraintsForVariable(const std::string &name, const types::Type &type) {
     ConstraintsState state = { "&" + name, name, type, true };
     auto paramType = type;
     if (type.maybeJustPointer()) {
@@ -36,8 +75,6 @@ KleeConstraintsPrinter::genConstraints(const std::string &name, const types::Typ
         default:
             genConstraintsForPrimitive(state);
     }
-
-    return ss;
 }
 
 printer::KleeConstraintsPrinter::Stream
@@ -55,7 +92,7 @@ void KleeConstraintsPrinter::genConstraintsForPrimitive(const ConstraintsState &
 }
 
 void KleeConstraintsPrinter::genConstraintsForEnum(const ConstraintsState &state) {
-    types::EnumInfo enumInfo = typesHandler->getEnumInfo(state.curType);
+    const types::EnumInfo &enumInfo = typesHandler->getEnumInfo(state.curType);
 
     std::stringstream _ss;
     for (auto it = enumInfo.namesToEntries.begin(); it != enumInfo.namesToEntries.end(); ++it) {
@@ -68,7 +105,7 @@ void KleeConstraintsPrinter::genConstraintsForEnum(const ConstraintsState &state
 }
 
 void KleeConstraintsPrinter::genConstraintsForUnion(const ConstraintsState &state) {
-    UnionInfo curUnion = typesHandler->getUnionInfo(state.curType);
+    const UnionInfo &curUnion = typesHandler->getUnionInfo(state.curType);
 
     for (const auto &field : curUnion.fields) {
         std::string errorMessage = "Unrecognized field of type '" + field.type.typeName() +
@@ -147,7 +184,7 @@ void KleeConstraintsPrinter::genConstraintsForPointerInStruct(const ConstraintsS
 }
 
 void KleeConstraintsPrinter::genConstraintsForStruct(const ConstraintsState &state) {
-    StructInfo curStruct = typesHandler->getStructInfo(state.curType);
+    const StructInfo &curStruct = typesHandler->getStructInfo(state.curType);
 
     for (const auto &field : curStruct.fields) {
         std::string errorMessage = "Unrecognized field of type '" + field.type.typeName() +
@@ -3,12 +3,27 @@
 
 #include "Printer.h"
 
+#include <string>
+#include <unordered_map>
+
 using tests::Tests;
 
 namespace printer {
     class KleeConstraintsPrinter: public Printer {
     public:
-        explicit KleeConstraintsPrinter(const types::TypesHandler *typesHandler, utbot::Language srcLanguage);
+        /**
+         * Constraints already printed for a type, with a placeholder instead of the variable
+         * name. Keyed by type handle, array flag, language and tabs depth.
+         */
+        using TemplateCache = std::unordered_map<std::string, std::string>;
+
+        /**
+         * @param templateCache if not null, constraints of every type are generated once and
+         * then instantiated for each variable of that type. Cache must outlive the printer.
+         */
+        explicit KleeConstraintsPrinter(const types::TypesHandler *typesHandler,
+                                        utbot::Language srcLanguage,
+                                        TemplateCache *templateCache = nullptr);
 
         utbot::Language getLanguage() const override;
 
@@ -22,6 +37,7 @@ namespace printer {
 
     private:
         types::TypesHandler const *typesHandler;
+        TemplateCache *templateCache;
 
         struct ConstraintsState {
             std::string paramName;
@@ -31,6 +47,10 @@ namespace printer {
             int depth = 0;
         };
 
+        void genConstraintsForVariable(const std::string &name, const types::Type &type);
+
+        [[nodiscard]] std::string getTemplateKey(const types::Type &type) const;
+
         void genConstraintsForPrimitive(const ConstraintsState &state);
 
         void genConstraintsForPointerOrArray(const ConstraintsState &state);
@@ -331,7 +331,7 @@ void KleePrinter::genParamsDeclarations(const Tests::MethodDescription &testMeth
         strDeclareVar(testMethod.classObj->type.typeName(), testMethod.classObj->name);
         strKleeMakeSymbolic(testMethod.classObj->type, testMethod.classObj->name, testMethod.classObj->name, true);
 
-        KleeConstraintsPrinter constraintsPrinter(typesHandler, srcLanguage);
+        KleeConstraintsPrinter constraintsPrinter(typesHandler, srcLanguage, &constraintsTemplates);
         constraintsPrinter.setTabsDepth(tabsDepth);
         const auto constraintsBlock = constraintsPrinter.genConstraints(testMethod.classObj->name,
                                                                         testMethod.classObj->type).str();
@@ -437,7 +437,7 @@ void KleePrinter::genParamsKleeAssumes(
 }
 
 void KleePrinter::genConstraints(const Tests::MethodParam &param, const std::string &methodName) {
-    KleeConstraintsPrinter constraintsPrinter(typesHandler, srcLanguage);
+    KleeConstraintsPrinter constraintsPrinter(typesHandler, srcLanguage, &constraintsTemplates);
     constraintsPrinter.setTabsDepth(tabsDepth);
     const auto constraintsBlock = constraintsPrinter.genConstraints(param).str();
     ss << constraintsBlock;
@@ -2,6 +2,7 @@
 #define UNITTESTBOT_KLEEPRINTER_H
 
 #include "PathSubstitution.h"
+#include "KleeConstraintsPrinter.h"
 #include "Printer.h"
 #include "ProjectContext.h"
 #include "Tests.h"
@@ -47,6 +48,8 @@ namespace printer {
     private:
         types::TypesHandler const *typesHandler;
         std::shared_ptr<BuildDatabase> buildDatabase;
+        // shared by all files printed with this printer, types repeat across functions
+        KleeConstraintsPrinter::TemplateCache constraintsTemplates;
 
         using PredInfo = LineInfo::PredicateInfo;
         struct ConstraintsState {
@@ -22,6 +22,13 @@ namespace printer {
     static const std::string STUB_OBJECT_FILES_NAME = "STUB_OBJECT_FILES";
     static const std::string STUB_OBJECT_FILES = "$(STUB_OBJECT_FILES)";
 
+    static const std::string SANITIZE_NAME = "UTBOT_SANITIZE";
+    static const std::string RECOMPILED_DIR_NAME = "RECOMPILED_DIR";
+    static const std::string TEST_OBJECTS_DIR_NAME = "TEST_OBJECTS_DIR";
+    static const std::string DEPENDENCIES_DIR_NAME = "DEPENDENCIES_DIR";
+    static const std::string SANITIZER_LINK_FLAGS_NAME = "SANITIZER_LINK_FLAGS";
+    static const std::string SANITIZER_PRELOAD_NAME = "SANITIZER_PRELOAD";
+
     static const std::string FPIC_FLAG = "-fPIC";
     static const std::vector<std::string> SANITIZER_NEEDED_FLAGS = {
         "-g", "-fno-omit-frame-pointer", "-fno-optimize-sibling-calls"
@@ -133,7 +140,7 @@ namespace printer {
           pthreadFlag(CompilationUtils::getPthreadFlag(primaryCxxCompilerName)),
           coverageLinkFlags(StringUtils::joinWith(
               CompilationUtils::getCoverageLinkFlags(primaryCxxCompilerName), " ")),
-          sanitizerLinkFlags(SanitizerUtils::getSanitizeLinkFlags(primaryCxxCompilerName)),
+          sanitizerLinkFlags(stringFormat("$(%s)", SANITIZER_LINK_FLAGS_NAME)),
 
           buildDirectory(Paths::getUtbotBuildDir(projectContext)),
           dependencyDirectory(buildDirectory / "dependencies"),
@@ -144,8 +151,9 @@ namespace printer {
     }
 
     void NativeMakefilePrinter::init() {
-
         declareAction(stringFormat("$(shell mkdir -p %s >/dev/null)", getRelativePath(buildDirectory)));
+        // variables are printed before any rule, so they aren't parsed as its recipe
+        sanitizerVariables();
         declareAction(stringFormat("$(shell mkdir -p %s >/dev/null)",
                                    getRelativePath(dependencyDirectory)));
         declareTarget(FORCE, {}, {});
@@ -163,6 +171,50 @@ namespace printer {
         comment("/gtest");
     }
 
+    static std::string getSanitizeCompileFlagsName(CompilationUtils::CompilerName compilerName) {
+        return "SANITIZER_COMPILE_FLAGS_" + CompilationUtils::to_string(compilerName);
+    }
+
+    void NativeMakefilePrinter::sanitizerVariables() {
+        comment("sanitizers");
+        ss << stringFormat("ifndef %s\n", SANITIZE_NAME);
+        declareVariable(SANITIZE_NAME, "1");
+        ss << "endif\n";
+        ss << stringFormat("ifeq ($(%s),1)\n", SANITIZE_NAME);
+        for (auto compilerName : { CompilationUtils::CompilerName::GCC, CompilationUtils::CompilerName::GXX,
+                                   CompilationUtils::CompilerName::CLANG, CompilationUtils::CompilerName::CLANGXX }) {
+            declareVariable(getSanitizeCompileFlagsName(compilerName),
+                            StringUtils::joinWith(SanitizerUtils::getSanitizeCompileFlags(compilerName), " "));
+        }
+        declareVariable(SANITIZER_LINK_FLAGS_NAME,
+                        SanitizerUtils::getSanitizeLinkFlags(primaryCxxCompilerName));
+        if (primaryCompilerName == CompilationUtils::CompilerName::GCC) {
+            declareVariable(SANITIZER_PRELOAD_NAME,
+                            getRelativePath(Paths::getAsanLibraryPath()).string() + ":");
+        }
+        ss << "endif\n";
+        // plain and sanitized builds have their own outputs, so switching modes rebuilds nothing
+        const std::vector<std::pair<std::string, fs::path>> modeDirectories = {
+            { RECOMPILED_DIR_NAME, Paths::getRecompiledDir(projectContext) },
+            { TEST_OBJECTS_DIR_NAME, Paths::getTestObjectDir(projectContext) },
+            { DEPENDENCIES_DIR_NAME, dependencyDirectory }
+        };
+        fs::path plainBuildDir = Paths::getPlainBuildDir(projectContext);
+        ss << stringFormat("ifeq ($(%s),1)\n", SANITIZE_NAME);
+        for (const auto &[name, directory] : modeDirectories) {
+            declareVariable(name, getRelativePath(directory).string());
+        }
+        ss << "else\n";
+        for (const auto &[name, directory] : modeDirectories) {
+            declareVariable(name, getRelativePath(plainBuildDir / directory.filename()).string());
+        }
+        ss << "endif\n";
+        for (const auto &[name, directory] : modeDirectories) {
+            pathToShellVariable[fs::weakly_canonical(directory)] = stringFormat("$(%s)", name);
+        }
+        comment("/sanitizers");
+    }
+
     fs::path NativeMakefilePrinter::getTemporaryDependencyFile(fs::path const &file) {
         fs::path relativePath = fs::relative(file, projectContext.projectPath);
         return getRelativePath(dependencyDirectory) /
@@ -233,9 +285,8 @@ namespace printer {
         compileCommand.setSourcePath(getRelativePath(sourcePath));
         compileCommand.setOutput(getRelativePath(target));
 
-        for (std::string& argument : compileCommand.getCommandLine()) {
-            tryChangeToRelativePath(argument);
-        }
+        compileCommand.transformArguments(
+            [this](std::string &argument) { tryChangeToRelativePath(argument); });
 
         compileCommand.setOptimizationLevel(OPTIMIZATION_FLAG);
         compileCommand.addEnvironmentVariable("C_INCLUDE_PATH", "$UTBOT_LAUNCH_INCLUDE_PATH");
@@ -243,7 +294,7 @@ namespace printer {
         compileCommand.addFlagsToBegin(SANITIZER_NEEDED_FLAGS);
         compileCommand.addFlagsToBegin(
             CompilationUtils::getCoverageCompileFlags(primaryCompilerName));
-        compileCommand.addFlagsToBegin(SanitizerUtils::getSanitizeCompileFlags(compilerName));
+        compileCommand.addFlagToBegin(stringFormat("$(%s)", getSanitizeCompileFlagsName(compilerName)));
 
         fs::path temporaryDependencyFile = getTemporaryDependencyFile(sourcePath);
         fs::path dependencyFile = getDependencyFile(sourcePath);
@@ -258,7 +309,8 @@ namespace printer {
         std::string postCompileAction =
             stringFormat("mv -f %s %s", temporaryDependencyFile, dependencyFile);
 
-        declareTarget(compileCommand.getOutput(), { compileCommand.getSourcePath(), dependencyFile },
+        declareTarget(compileCommand.getOutput(),
+                      { compileCommand.getSourcePath(), dependencyFile },
                       { makingDependencyDirectory,
                         compileCommand.toStringWithChangingDirectoryToNew(
                                 getRelativePath(compileCommand.getDirectory())),
@@ -361,10 +413,10 @@ namespace printer {
                        StringUtils::startsWith(argument, libraryDirOption) ||
                        StringUtils::startsWith(argument, linkFlag);
             });
-            for (std::string &argument : dynamicLinkCommand.getCommandLine()) {
+            dynamicLinkCommand.transformArguments([](std::string &argument) {
                 removeScriptFlag(argument);
                 removeSonameFlag(argument);
-            }
+            });
             dynamicLinkCommand.setOptimizationLevel(OPTIMIZATION_FLAG);
             dynamicLinkCommand.addFlagsToBegin(
                 { pthreadFlag, coverageLinkFlags, sanitizerLinkFlags });
@@ -441,8 +493,8 @@ namespace printer {
                                           getRelativePath(buildDirectory) };
         testRunCommand.addEnvironmentVariable("PATH", "$$PATH:$(pwd)");
         if (primaryCompilerName == CompilationUtils::CompilerName::GCC) {
-            testRunCommand.addEnvironmentVariable("LD_PRELOAD",
-                                                  getRelativePath(Paths::getAsanLibraryPath()).string() + ":${LD_PRELOAD}");
+            testRunCommand.addEnvironmentVariable(
+                "LD_PRELOAD", stringFormat("$(%s)${LD_PRELOAD}", SANITIZER_PRELOAD_NAME));
         }
         testRunCommand.addEnvironmentVariable(SanitizerUtils::UBSAN_OPTIONS_NAME,
                                               SanitizerUtils::UBSAN_OPTIONS_VALUE);
@@ -507,23 +559,21 @@ namespace printer {
             CollectionUtils::transform(linkUnitInfo->commands, [&](utbot::LinkCommand linkCommand) {
                 linkCommand.erase(STATIC_FLAG);
                 linkCommand.setOutput(recompiledFile);
-                for (std::string &argument : linkCommand.getCommandLine()) {
+                linkCommand.transformArguments([&](std::string &argument) {
                     if (CollectionUtils::contains(linkUnitInfo->files, argument)) {
                         argument = fileMapping.at(argument);
                     }
-                }
+                });
                 if (!linkCommand.isArchiveCommand()) {
                     if (isExecutable && !transformExeToLib) {
                         linkCommand.setLinker(Paths::getLd());
-                        for (std::string &argument : linkCommand.getCommandLine()) {
-                            transformCompilerFlagsToLinkerFlags(argument);
-                        }
+                        linkCommand.transformArguments(transformCompilerFlagsToLinkerFlags);
                     } else {
                         linkCommand.setLinker(CompilationUtils::getBundledCompilerPath(
                                 CompilationUtils::getCompilerName(linkCommand.getLinker())));
                     }
                     std::vector <std::string> libraryDirectoriesFlags;
-                    for (std::string &argument : linkCommand.getCommandLine()) {
+                    linkCommand.transformArguments([&](std::string &argument) {
                         removeScriptFlag(argument);
                         removeSonameFlag(argument);
                         auto optionalLibraryAbsolutePath =
@@ -537,7 +587,7 @@ namespace printer {
                                 libraryDirectoriesFlags.push_back(directoryFlag);
                             }
                         }
-                    }
+                    });
                     linkCommand.addFlagsToBegin(libraryDirectoriesFlags);
                     if (!isExecutable || transformExeToLib) {
                         linkCommand.addFlagsToBegin({"-Wl,--allow-multiple-definition",
@@ -557,9 +607,8 @@ namespace printer {
 
                 linkCommand.setLinker(getRelativePathForLinker(linkCommand.getLinker()));
 
-                for (std::string &argument : linkCommand.getCommandLine()) {
-                    tryChangeToRelativePath(argument);
-                }
+                linkCommand.transformArguments(
+                    [this](std::string &argument) { tryChangeToRelativePath(argument); });
 
                 const fs::path relativeDir = getRelativePath(linkCommand.getDirectory());
 
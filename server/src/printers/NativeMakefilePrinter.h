@@ -38,6 +38,13 @@ namespace printer {
 
         std::optional<fs::path> sharedOutput;
 
+        /**
+         * Declares sanitizer flags which are empty unless UTBOT_SANITIZE is 1, so the same makefile
+         * builds either sanitized or plain tests. Each mode has its own object, test object and
+         * dependency directories.
+         */
+        void sanitizerVariables();
+
         fs::path getTemporaryDependencyFile(fs::path const &file);
 
         fs::path getDependencyFile(fs::path const &file);
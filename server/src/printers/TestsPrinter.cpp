@@ -3,6 +3,7 @@
 #include "Paths.h"
 #include "SARIFGenerator.h"
 #include "utils/Copyright.h"
+#include "utils/HashUtils.h"
 #include "utils/JsonUtils.h"
 #include "visitors/ParametrizedAssertsVisitor.h"
 #include "visitors/VerboseAssertsParamVisitor.h"
@@ -50,6 +51,9 @@ void TestsPrinter::joinToFinalCode(Tests &tests, const fs::path& generatedHeader
 
     strDeclareAbsError(PrinterUtils::ABS_ERROR);
 
+    for (const auto &skipRecord : tests.skipRecords) {
+        strComment(skipRecord.toCommentBlock()) << NL;
+    }
     for (const auto &commentBlock : tests.commentBlocks) {
         strComment(commentBlock) << NL;
     }
@@ -121,6 +125,25 @@ void TestsPrinter::printFinalCodeAndAlterJson(Tests &tests) {
     }
 }
 
+void TestsPrinter::printTestManifest(const Tests &tests, const fs::path &manifestPath) {
+    json testsJson = json::array();
+    for (const auto &suiteName : { Tests::DEFAULT_SUITE_NAME, Tests::ERROR_SUITE_NAME }) {
+        for (const auto &[methodName, methodDescription] : tests.methods) {
+            if (methodDescription.codeText.at(suiteName).empty()) {
+                continue;
+            }
+            for (int testCaseIndex : methodDescription.suiteTestCases.at(suiteName)) {
+                const auto &testCase = methodDescription.testCases[testCaseIndex];
+                testsJson.push_back({ { "suite", testCase.suiteName },
+                                      { "name", testCase.testName } });
+            }
+        }
+    }
+    json manifest = { { "hash", HashUtils::contentHash(tests.code) }, { "tests", testsJson } };
+    fs::create_directories(manifestPath.parent_path());
+    JsonUtils::writeJsonToFile(manifestPath, manifest);
+}
+
 std::uint32_t TestsPrinter::printSuiteAndReturnMethodsCount(const std::string &suiteName, const Tests::MethodsMap &methods) {
     if (std::all_of(methods.begin(), methods.end(), [&suiteName](const auto& method) {
         return method.second.codeText.at(suiteName).empty();
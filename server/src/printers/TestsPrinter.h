@@ -30,6 +30,12 @@ namespace printer {
 
         void joinToFinalCode(Tests &tests, const fs::path &generatedHeaderPath);
 
+        /**
+         * Writes suite and test names of the printed test file together with hash of its code,
+         * so tests can be enumerated without building the test executable.
+         */
+        static void printTestManifest(const Tests &tests, const fs::path &manifestPath);
+
         static bool needsMathHeader(const Tests &tests);
 
         void genHeaders(Tests &tests, const fs::path &generatedHeaderPath);
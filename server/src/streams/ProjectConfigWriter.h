@@ -8,7 +8,7 @@
 
 class ProjectConfigWriter : public utbot::ServerWriter<testsgen::ProjectConfigResponse> {
 public:
-    explicit ProjectConfigWriter(grpc::ServerWriter<testsgen::ProjectConfigResponse> *writer)
+    explicit ProjectConfigWriter(grpc::ServerWriterInterface<testsgen::ProjectConfigResponse> *writer)
         : ServerWriter(writer) {
     }
 
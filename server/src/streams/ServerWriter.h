@@ -6,11 +6,11 @@
 
 namespace utbot {
     template <typename Response>
-    class ServerWriter : public BaseWriter<Response, grpc::ServerWriter<Response>>,
+    class ServerWriter : public BaseWriter<Response, grpc::ServerWriterInterface<Response>>,
                          public ProgressWriter {
     public:
-        explicit ServerWriter(grpc::ServerWriter<Response> *writer)
-            : BaseWriter<Response, grpc::ServerWriter<Response>>(writer) {
+        explicit ServerWriter(grpc::ServerWriterInterface<Response> *writer)
+            : BaseWriter<Response, grpc::ServerWriterInterface<Response>>(writer) {
         }
 
         void writeProgress(const std::optional<std::string> &message,
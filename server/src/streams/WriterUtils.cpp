@@ -1,5 +1,115 @@
 #include "WriterUtils.h"
 
+#include "utils/HashUtils.h"
+
+#include <iterator>
+#include <string>
+
 void writeSourceLine(testsgen::SourceLine *sourceLineGrpc, Coverage::FileCoverage::SourceLine sourceLine) {
     sourceLineGrpc->set_line(sourceLine.line);
 }
+
+static bool isUtf8Continuation(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// UTF-8 character is at most 4 bytes long, so 3 bytes after the limit are enough to find
+// the end of the character that crosses it
+static const size_t MAX_UTF8_CONTINUATION = 3;
+
+/**
+ * @param code rest of the code, which may be truncated after maxChunkSize +
+ * MAX_UTF8_CONTINUATION bytes.
+ * @return size of the next chunk.
+ */
+static size_t getChunkSize(std::string_view code, size_t maxChunkSize) {
+    if (maxChunkSize == 0 || code.size() <= maxChunkSize) {
+        return code.size();
+    }
+    size_t size = maxChunkSize;
+    while (size > 0 && isUtf8Continuation(code[size])) {
+        --size;
+    }
+    if (size == 0) {
+        // limit is less than one character, so the chunk is a bit longer
+        size = maxChunkSize;
+        while (size < code.size() && isUtf8Continuation(code[size])) {
+            ++size;
+        }
+    }
+    return size;
+}
+
+static void consumeChunk(const testsgen::SourceCode &source,
+                         std::string_view code,
+                         size_t offset,
+                         bool hasMoreChunks,
+                         const SourceConsumer &consumer) {
+    testsgen::SourceCode chunk = source;
+    chunk.set_code(std::string(code));
+    chunk.set_codeoffset(offset);
+    chunk.set_hasmorechunks(hasMoreChunks);
+    consumer(std::move(chunk));
+}
+
+void splitIntoChunks(const testsgen::SourceCode &source,
+                     std::string_view code,
+                     size_t maxChunkSize,
+                     const SourceConsumer &consumer) {
+    size_t offset = 0;
+    do {
+        size_t size = getChunkSize(code.substr(offset), maxChunkSize);
+        consumeChunk(source, code.substr(offset, size), offset, offset + size < code.size(),
+                     consumer);
+        offset += size;
+    } while (offset < code.size());
+}
+
+void splitIntoChunks(const testsgen::SourceCode &source,
+                     std::istream &code,
+                     size_t maxChunkSize,
+                     const SourceConsumer &consumer) {
+    if (maxChunkSize == 0) {
+        std::string content(std::istreambuf_iterator<char>(code), {});
+        splitIntoChunks(source, content, maxChunkSize, consumer);
+        return;
+    }
+    std::string pending;
+    size_t offset = 0;
+    bool isEnd = false;
+    do {
+        // read one byte more than a chunk needs, to know whether it is the last one
+        size_t lookahead = maxChunkSize + MAX_UTF8_CONTINUATION + 1;
+        if (!isEnd && pending.size() < lookahead) {
+            size_t start = pending.size();
+            pending.resize(lookahead);
+            code.read(pending.data() + start, lookahead - start);
+            pending.resize(start + code.gcount());
+            isEnd = pending.size() < lookahead;
+        }
+        size_t size = getChunkSize(pending, maxChunkSize);
+        consumeChunk(source, std::string_view(pending).substr(0, size), offset,
+                     size < pending.size(), consumer);
+        pending.erase(0, size);
+        offset += size;
+    } while (!pending.empty());
+}
+
+size_t getMaxChunkSize(const testsgen::TransferOptions &options) {
+    return options.maxchunksize() != 0 ? options.maxchunksize() : DEFAULT_MAX_CHUNK_SIZE;
+}
+
+void packSourceCode(const testsgen::SourceCode &source,
+                    std::string_view code,
+                    bool synchronizeCode,
+                    const testsgen::TransferOptions &options,
+                    const SourceConsumer &consumer) {
+    if (options.sharedfilesystem()) {
+        testsgen::SourceCode entry = source;
+        entry.set_contenthash(HashUtils::contentHash(code));
+        consumer(std::move(entry));
+        return;
+    }
+    splitIntoChunks(source, synchronizeCode ? code : std::string_view(), getMaxChunkSize(options),
+                    consumer);
+}
@@ -6,6 +6,59 @@
 
 #include <protobuf/testgen.grpc.pb.h>
 
+#include <functional>
+#include <istream>
+#include <string_view>
+
 void writeSourceLine(testsgen::SourceLine *sourceLineGrpc, Coverage::FileCoverage::SourceLine sourceLine);
 
+/**
+ * Receives chunks one by one, so that a chunk can be sent before the next one is built.
+ */
+using SourceConsumer = std::function<void(testsgen::SourceCode &&)>;
+
+/**
+ * Chunk size of responses to clients that leave TransferOptions.maxChunkSize at 0.
+ */
+const size_t DEFAULT_MAX_CHUNK_SIZE = 1 << 20;
+
+/**
+ * Chunk size requested by the client, or DEFAULT_MAX_CHUNK_SIZE.
+ */
+size_t getMaxChunkSize(const testsgen::TransferOptions &options);
+
+/**
+ * Splits code of a file into chunks of at most maxChunkSize bytes. Chunks are cut on
+ * UTF-8 character boundaries, since protobuf strings must be valid UTF-8.
+ * @param source file description without code, it is copied to every chunk.
+ * @param maxChunkSize 0 means that the code is not split.
+ * @param consumer receives at least one chunk; all chunks but the last one have
+ * hasMoreChunks set and codeOffset of every chunk is its position in the code.
+ */
+void splitIntoChunks(const testsgen::SourceCode &source,
+                     std::string_view code,
+                     size_t maxChunkSize,
+                     const SourceConsumer &consumer);
+
+/**
+ * Same as splitIntoChunks for code read from stream. If maxChunkSize is not 0, only
+ * one chunk of the code is kept in memory.
+ */
+void splitIntoChunks(const testsgen::SourceCode &source,
+                     std::istream &code,
+                     size_t maxChunkSize,
+                     const SourceConsumer &consumer);
+
+/**
+ * Describes a file written on server for a response. If client shares file system with
+ * server, the description is a manifest entry with hash of the code. Otherwise the code
+ * is attached if it is synchronized, split into chunks of getMaxChunkSize(options).
+ * @param source file description without code.
+ */
+void packSourceCode(const testsgen::SourceCode &source,
+                    std::string_view code,
+                    bool synchronizeCode,
+                    const testsgen::TransferOptions &options,
+                    const SourceConsumer &consumer);
+
 #endif //UNITTESTBOT_WRITERUTILS_H
@@ -1,6 +1,6 @@
 #include "CoverageAndResultsWriter.h"
 
 CoverageAndResultsWriter::CoverageAndResultsWriter(
-    grpc::ServerWriter<testsgen::CoverageAndResultsResponse> *writer)
+    grpc::ServerWriterInterface<testsgen::CoverageAndResultsResponse> *writer)
     : ServerWriter(writer) {
 }
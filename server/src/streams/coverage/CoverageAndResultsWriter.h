@@ -13,7 +13,7 @@
 class CoverageAndResultsWriter : public utbot::ServerWriter<testsgen::CoverageAndResultsResponse> {
 public:
 
-    explicit CoverageAndResultsWriter(grpc::ServerWriter<testsgen::CoverageAndResultsResponse> *writer);
+    explicit CoverageAndResultsWriter(grpc::ServerWriterInterface<testsgen::CoverageAndResultsResponse> *writer);
 
     virtual void writeResponse(const utbot::ProjectContext &projectContext,
                                const Coverage::TestResultMap &testsResultMap,
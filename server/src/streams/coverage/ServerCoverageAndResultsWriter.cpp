@@ -5,7 +5,7 @@
 #include "loguru.h"
 
 ServerCoverageAndResultsWriter::ServerCoverageAndResultsWriter(
-    grpc::ServerWriter<testsgen::CoverageAndResultsResponse> *writer)
+    grpc::ServerWriterInterface<testsgen::CoverageAndResultsResponse> *writer)
     : CoverageAndResultsWriter(writer) {
 }
 
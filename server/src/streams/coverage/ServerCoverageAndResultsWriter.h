@@ -13,7 +13,7 @@
 class ServerCoverageAndResultsWriter : public CoverageAndResultsWriter {
 public:
     explicit ServerCoverageAndResultsWriter(
-        grpc::ServerWriter<testsgen::CoverageAndResultsResponse> *writer);
+        grpc::ServerWriterInterface<testsgen::CoverageAndResultsResponse> *writer);
 
     virtual void writeResponse(const utbot::ProjectContext &projectContext,
                                const Coverage::TestResultMap &testResultMap,
@@ -1,11 +1,11 @@
 #include "CLIStubsWriter.h"
 
-#include <utils/FileSystemUtils.h>
 #include "loguru.h"
 
-void CLIStubsWriter::writeResponse(const std::vector<Stubs> &synchronizedStubs,
-                                   const fs::path &testDirPath) {
-    LOG_S(INFO) << "Writing stubs...";
-    writeStubsFilesOnServer(synchronizedStubs, testDirPath);
+void CLIStubsWriter::writeStub(const Stubs &stub, double percent) {
+    LOG_S(DEBUG) << "Stub written: " << stub.filePath;
+}
+
+void CLIStubsWriter::writeCompleted() {
     LOG_S(INFO) << "Stubs generated";
 }
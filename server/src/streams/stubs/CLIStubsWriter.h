@@ -8,7 +8,9 @@ class CLIStubsWriter : public StubsWriter {
 public:
     explicit CLIStubsWriter(): StubsWriter(nullptr) {};
 
-    void writeResponse(const std::vector<Stubs> &synchronizedStubs, const fs::path &testDirPath) override;
+    void writeStub(const Stubs &stub, double percent) override;
+
+    void writeCompleted() override;
 
 };
 
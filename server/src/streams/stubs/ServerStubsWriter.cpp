@@ -1,22 +1,32 @@
 #include "ServerStubsWriter.h"
 
+#include "streams/WriterUtils.h"
+
 #include "loguru.h"
 
-void ServerStubsWriter::writeResponse(const std::vector<Stubs> &synchronizedStubs,
-                                      const fs::path &testDirPath) {
-    writeStubsFilesOnServer(synchronizedStubs, testDirPath);
+void ServerStubsWriter::writeStub(const Stubs &stub, double percent) {
     if (!hasStream()) {
         return;
     }
-    testsgen::StubsResponse response;
-    LOG_S(DEBUG) << "Creating final response.";
-    for (const auto &synchronizedStub : synchronizedStubs) {
-        auto sData = response.add_stubsources();
-        sData->set_filepath(synchronizedStub.filePath);
-        if (synchronizeCode) {
-            sData->set_code(synchronizedStub.code);
-        }
+    testsgen::SourceCode stubSource;
+    stubSource.set_filepath(stub.filePath);
+    packSourceCode(stubSource, stub.code, synchronizeCode, transferOptions,
+                   [&](testsgen::SourceCode &&chunk) {
+                       // one chunk per response, so only the chunk being sent is packed
+                       testsgen::StubsResponse response;
+                       *response.add_stubsources() = std::move(chunk);
+                       auto progress = GrpcUtils::createProgress(std::nullopt, percent, false);
+                       response.set_allocated_progress(progress.release());
+                       writeMessage(response);
+                   });
+}
+
+void ServerStubsWriter::writeCompleted() {
+    if (!hasStream()) {
+        return;
     }
+    LOG_S(DEBUG) << "Creating final response.";
+    testsgen::StubsResponse response;
     auto progress = GrpcUtils::createProgress(std::nullopt, 0, true);
     response.set_allocated_progress(progress.release());
     writeMessage(response);
@@ -5,14 +5,23 @@
 
 class ServerStubsWriter : public StubsWriter {
 public:
-    explicit ServerStubsWriter(grpc::ServerWriter<testsgen::StubsResponse> *writer, bool synchronizeCode)
-        : StubsWriter(writer), synchronizeCode(synchronizeCode) {
+    /**
+     * @param transferOptions every stub file is sent in separate responses before the
+     * completing one, files longer than maxChunkSize are split into several responses.
+     */
+    explicit ServerStubsWriter(grpc::ServerWriterInterface<testsgen::StubsResponse> *writer,
+                               bool synchronizeCode,
+                               testsgen::TransferOptions transferOptions = {})
+        : StubsWriter(writer), synchronizeCode(synchronizeCode),
+          transferOptions(std::move(transferOptions)) {
     }
 
-    void writeResponse(const std::vector<Stubs> &synchronizedStubs,
-                       const fs::path &testDirPath) override;
+    void writeStub(const Stubs &stub, double percent) override;
+
+    void writeCompleted() override;
 private:
     bool synchronizeCode;
+    testsgen::TransferOptions transferOptions;
 };
 
 
@@ -6,11 +6,9 @@
 
 #include "loguru.h"
 
-StubsWriter::StubsWriter(grpc::ServerWriter<testsgen::StubsResponse> *writer) : ServerWriter(writer) {
+StubsWriter::StubsWriter(grpc::ServerWriterInterface<testsgen::StubsResponse> *writer) : ServerWriter(writer) {
 }
 
-void StubsWriter::writeStubsFilesOnServer(const std::vector<Stubs> &stubs, const fs::path &testDirPath) {
-    for (const auto &stub : stubs) {
-        FileSystemUtils::writeToFile(stub.filePath, stub.code);
-    }
+void StubsWriter::writeStubFileOnServer(const Stubs &stub) {
+    FileSystemUtils::writeToFileIfChanged(stub.filePath, stub.code);
 }
@@ -10,11 +10,21 @@
 
 class StubsWriter : public utbot::ServerWriter<testsgen::StubsResponse> {
 public:
-    explicit StubsWriter(grpc::ServerWriter<testsgen::StubsResponse> *writer);
+    explicit StubsWriter(grpc::ServerWriterInterface<testsgen::StubsResponse> *writer);
 
-    virtual void writeResponse(const std::vector<Stubs> &synchronizedStubs, const fs::path &testDirPath) = 0;
+    /**
+     * Called for every stub as soon as it is synchronized and written on server, so stubs
+     * of the whole project are never kept together.
+     * @param percent part of the stubs synchronized before this one.
+     */
+    virtual void writeStub(const Stubs &stub, double percent) = 0;
 
-    static void writeStubsFilesOnServer(const std::vector<Stubs> &stubs, const fs::path &testDirPath);
+    /**
+     * Completes the response once all stubs are written.
+     */
+    virtual void writeCompleted() = 0;
+
+    static void writeStubFileOnServer(const Stubs &stub);
 
 };
 
@@ -16,7 +16,7 @@ public:
                                 std::function<void(tests::Tests &)> &&prepareTests,
                                 std::function<void()> &&prepareTotal) override;
 
-    void writeReport(const std::string &content,
+    void writeReport(sarif::SarifStreamWriter &report,
                      const std::string &message,
                      const fs::path &pathToStore) const override;
 
@@ -1,5 +1,7 @@
 #include "ServerTestsWriter.h"
 
+#include "SARIFGenerator.h"
+#include "streams/WriterUtils.h"
 #include "utils/FileSystemUtils.h"
 
 #include "loguru.h"
@@ -34,53 +36,79 @@ bool ServerTestsWriter::writeFileAndSendResponse(const tests::Tests &tests,
                                                  bool isCompleted) const {
     fs::path testFilePath = testDirPath / tests.relativeFileDir / tests.testFilename;
     if (!tests.code.empty()) {
-        FileSystemUtils::writeToFile(testFilePath, tests.code);
+        FileSystemUtils::writeToFileIfChanged(testFilePath, tests.code);
     }
     if (!hasStream()) {
         return false;
     }
-    testsgen::TestsResponse response;
     LOG_S(DEBUG) << "Creating final response.";
-    bool isAnyTestsGenerated = false;
-    if (!tests.code.empty()) {
-        isAnyTestsGenerated = true;
-        auto testSource = response.add_testsources();
-        testSource->set_filepath(tests.testSourceFilePath);
-        if (synchronizeCode) {
-            testSource->set_code(tests.code);
-        }
-        testSource->set_errormethodsnumber(tests.errorMethodsNumber);
-        testSource->set_regressionmethodsnumber(tests.regressionMethodsNumber);
-
-        auto testHeader = response.add_testsources();
-        testHeader->set_filepath(tests.testHeaderFilePath);
-        if (synchronizeCode) {
-            testHeader->set_code(tests.headerCode);
-        }
-    }
+    bool isAnyTestsGenerated = !tests.code.empty();
     LOG_S(INFO) << message;
-    auto progress = GrpcUtils::createProgress(message, percent, isCompleted);
-    response.set_allocated_progress(progress.release());
-    writeMessage(response);
+    writeSources(
+        [&](const SourceConsumer &consumer) {
+            if (!isAnyTestsGenerated) {
+                return;
+            }
+            testsgen::SourceCode testSource;
+            testSource.set_filepath(tests.testSourceFilePath);
+            testSource.set_errormethodsnumber(tests.errorMethodsNumber);
+            testSource.set_regressionmethodsnumber(tests.regressionMethodsNumber);
+            packSourceCode(testSource, tests.code, synchronizeCode, transferOptions, consumer);
+
+            testsgen::SourceCode testHeader;
+            testHeader.set_filepath(tests.testHeaderFilePath);
+            packSourceCode(testHeader, tests.headerCode, synchronizeCode, transferOptions,
+                           consumer);
+        },
+        message, percent, isCompleted);
     return isAnyTestsGenerated;
 }
 
-void ServerTestsWriter::writeReport(const std::string &content,
+void ServerTestsWriter::writeReport(sarif::SarifStreamWriter &report,
                                     const std::string &message,
                                     const fs::path &pathToStore) const
 {
-    testsgen::TestsResponse response;
-    TestsWriter::writeReport(content, message, pathToStore);
+    TestsWriter::writeReport(report, message, pathToStore);
 
-    auto testSource = response.add_testsources();
-    testSource->set_filepath(pathToStore);
-    if (synchronizeCode) {
-        // write the content only for real data transfer
-        // `synchronizeCode` is false if client and server share the same FS
-        testSource->set_code(content);
-    }
+    testsgen::SourceCode testSource;
+    testSource.set_filepath(pathToStore);
     LOG_S(INFO) << message;
-    auto progress = GrpcUtils::createProgress(message, 100, false);
+    writeSources(
+        [&](const SourceConsumer &consumer) {
+            if (transferOptions.sharedfilesystem()) {
+                // the hash was computed while the report was streamed, so it is not read back
+                testSource.set_contenthash(report.contentHash());
+                consumer(std::move(testSource));
+            } else if (synchronizeCode) {
+                // read the content only for real data transfer
+                // `synchronizeCode` is false if client and server share the same FS
+                std::ifstream stream(pathToStore);
+                splitIntoChunks(testSource, stream, getMaxChunkSize(transferOptions), consumer);
+            } else {
+                splitIntoChunks(testSource, std::string_view(), 0, consumer);
+            }
+        },
+        message, 100, false);
+}
+
+void ServerTestsWriter::writeSources(const std::function<void(const SourceConsumer &)> &packSources,
+                                     const std::string &message,
+                                     double percent,
+                                     bool isCompleted) const {
+    testsgen::TestsResponse response;
+    packSources([&](testsgen::SourceCode &&source) {
+        if (response.testsources_size() > 0) {
+            // one chunk per response, so a response is never much larger than maxChunkSize
+            // and only the chunk being sent is kept in memory; the previous chunk is sent
+            // when it is known not to be the last one
+            auto progress = GrpcUtils::createProgress(message, percent, false);
+            response.set_allocated_progress(progress.release());
+            writeMessage(response);
+            response.Clear();
+        }
+        *response.add_testsources() = std::move(source);
+    });
+    auto progress = GrpcUtils::createProgress(message, percent, isCompleted);
     response.set_allocated_progress(progress.release());
     writeMessage(response);
 }
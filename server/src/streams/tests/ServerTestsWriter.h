@@ -4,14 +4,23 @@
 #include "Tests.h"
 #include "TestsWriter.h"
 #include "streams/IStreamWriter.h"
+#include "streams/WriterUtils.h"
 
 #include <utils/FileSystemUtils.h>
 
+#include <functional>
+
 class ServerTestsWriter : public TestsWriter {
 public:
-    explicit ServerTestsWriter(grpc::ServerWriter<testsgen::TestsResponse> *writer,
-                               bool synchronizeCode)
-        : TestsWriter(writer), synchronizeCode(synchronizeCode)  {};
+    /**
+     * @param transferOptions every file is sent in a separate response, files longer than
+     * maxChunkSize are split into several responses.
+     */
+    explicit ServerTestsWriter(grpc::ServerWriterInterface<testsgen::TestsResponse> *writer,
+                               bool synchronizeCode,
+                               testsgen::TransferOptions transferOptions = {})
+        : TestsWriter(writer), synchronizeCode(synchronizeCode),
+          transferOptions(std::move(transferOptions)) {};
 
     void writeTestsWithProgress(tests::TestsMap &testMap,
                                 const std::string &message,
@@ -19,7 +28,7 @@ public:
                                 std::function<void(tests::Tests &)> &&prepareTests,
                                 std::function<void()> &&prepareTotal) override;
 
-    void writeReport(const std::string &content,
+    void writeReport(sarif::SarifStreamWriter &report,
                      const std::string &message,
                      const fs::path &pathToStore) const override;
 
@@ -30,7 +39,17 @@ private:
                                                         double percent,
                                                         bool isCompleted) const;
 
+    /**
+     * Sends sources produced by packSources. Every source is sent in a separate response
+     * as soon as the next one is produced.
+     */
+    void writeSources(const std::function<void(const SourceConsumer &)> &packSources,
+                      const std::string &message,
+                      double percent,
+                      bool isCompleted) const;
+
     bool synchronizeCode;
+    testsgen::TransferOptions transferOptions;
 };
 
 
@@ -6,7 +6,7 @@
 #include "loguru.h"
 
 
-TestsWriter::TestsWriter(grpc::ServerWriter<testsgen::TestsResponse> *writer): ServerWriter(writer) {}
+TestsWriter::TestsWriter(grpc::ServerWriterInterface<testsgen::TestsResponse> *writer): ServerWriter(writer) {}
 
 void TestsWriter::writeCompleted(const tests::TestsMap &testMap, int totalTestsCounter) {
     std::string finalMessage;
@@ -18,10 +18,11 @@ void TestsWriter::writeCompleted(const tests::TestsMap &testMap, int totalTestsC
     writeProgress(finalMessage, 100.0, true);
 }
 
-void TestsWriter::writeReport(const std::string &content,
+void TestsWriter::writeReport(sarif::SarifStreamWriter &report,
                               const std::string &message,
                               const fs::path &pathToStore) const
 {
+    const fs::path &reportPath = report.close();
     try {
         backupIfExists(pathToStore);
     } catch (const std::exception &e) {
@@ -29,7 +30,12 @@ void TestsWriter::writeReport(const std::string &content,
                      << ": problem in `writeReport` with "
                      << pathToStore;
     }
-    FileSystemUtils::writeToFile(pathToStore, content);
+    try {
+        fs::rename(reportPath, pathToStore);
+    } catch (...) {
+        fs::remove(reportPath);
+        throw;
+    }
 }
 
 template <typename TP>
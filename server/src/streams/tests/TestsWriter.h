@@ -10,9 +10,13 @@
 
 #include <protobuf/testgen.grpc.pb.h>
 
+namespace sarif {
+    class SarifStreamWriter;
+}
+
 class TestsWriter : public utbot::ServerWriter<testsgen::TestsResponse> {
 public:
-    explicit TestsWriter(grpc::ServerWriter<testsgen::TestsResponse> *writer);
+    explicit TestsWriter(grpc::ServerWriterInterface<testsgen::TestsResponse> *writer);
 
     virtual void writeTestsWithProgress(tests::TestsMap &testMap,
                                         const std::string &message,
@@ -20,7 +24,11 @@ public:
                                         std::function<void(tests::Tests &)> &&prepareTests,
                                         std::function<void()> &&prepareTotal) = 0;
 
-    virtual void writeReport(const std::string &content,
+    /**
+     * Closes the report and moves it to pathToStore, keeping a backup of the previous one.
+     * The unfinished report file is removed if it can't be moved.
+     */
+    virtual void writeReport(sarif::SarifStreamWriter &report,
                              const std::string &message,
                              const fs::path &pathToStore) const;
 
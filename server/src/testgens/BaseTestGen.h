@@ -30,7 +30,6 @@ public:
     CollectionUtils::FileSet sourcePaths, testingMethodsSourcePaths;
     tests::TestsMap tests;
     std::unordered_map<std::string, types::Type> methodNameToReturnTypeMap;
-    std::vector<Stubs> synchronizedStubs;
     types::TypeMaps types;
 
     std::optional<fs::path> targetPath;
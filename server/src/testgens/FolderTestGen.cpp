@@ -1,17 +1,36 @@
 #include "FolderTestGen.h"
 
 #include "Paths.h"
+#include "building/BuildDatabase.h"
+#include "exceptions/CompilationDatabaseException.h"
+
+#include "loguru.h"
 
 FolderTestGen::FolderTestGen(const testsgen::FolderRequest &request,
                              ProgressWriter *progressWriter,
                              bool testMode)
     : ProjectTestGen(request.projectrequest(), progressWriter, testMode, false),
       folderPath(request.folderpath()) {
-    testingMethodsSourcePaths = CollectionUtils::filterOut(sourcePaths,
-                 [this](const fs::path &path) { return !Paths::isSubPathOf(folderPath, path); });
+    testingMethodsSourcePaths = compilationDatabase->getFilesUnder(folderPath);
+    sourcePaths = getLinkedSourcePaths();
     setInitializedTestsMap();
 }
 
+CollectionUtils::FileSet FolderTestGen::getLinkedSourcePaths() const {
+    try {
+        CollectionUtils::FileSet linkedSourcePaths =
+            buildDatabase->getLinkedSourcePaths(testingMethodsSourcePaths);
+        CollectionUtils::extend(linkedSourcePaths, testingMethodsSourcePaths);
+        LOG_S(DEBUG) << "Folder request uses " << linkedSourcePaths.size() << " of "
+                     << compilationDatabase->getAllFiles().size() << " project sources";
+        return linkedSourcePaths;
+    } catch (const CompilationDatabaseException &e) {
+        LOG_S(DEBUG) << "Couldn't find targets of the folder, using all project sources: "
+                     << e.what();
+        return sourcePaths;
+    }
+}
+
 std::string FolderTestGen::toString() {
     std::stringstream s;
     s << ProjectTestGen::toString() << "folder path: " << folderPath << "\nfile paths:\n";
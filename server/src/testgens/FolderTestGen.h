@@ -15,6 +15,13 @@ public:
     ~FolderTestGen() override = default;
 
     std::string toString() override;
+
+private:
+    /**
+     * Sources under the folder and sources linked into the same targets as them.
+     * Only these sources are synchronized for the request.
+     */
+    CollectionUtils::FileSet getLinkedSourcePaths() const;
 };
 
 
@@ -21,11 +21,11 @@ ProjectTestGen::ProjectTestGen(const testsgen::ProjectRequest &request,
     compilationDatabase = CompilationUtils::getCompilationDatabase(compileCommandsJsonPath);
     if (autoDetect) {
         autoDetectSourcePathsIfNotEmpty();
+        testingMethodsSourcePaths = sourcePaths;
+        setInitializedTestsMap();
     } else {
         sourcePaths = compilationDatabase->getAllFiles();
     }
-    testingMethodsSourcePaths = sourcePaths;
-    setInitializedTestsMap();
 }
 
 std::string ProjectTestGen::toString() {
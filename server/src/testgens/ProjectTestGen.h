@@ -8,6 +8,11 @@
 
 class ProjectTestGen : public BaseTestGen {
 public:
+    /**
+     * @param autoDetect if false, the request is narrower than the whole project: source paths
+     * are all files of the compilation database, and the derived class chooses tested sources and
+     * initializes tests itself, so tests of the whole project are never created.
+     */
     ProjectTestGen(const testsgen::ProjectRequest &request,
                    ProgressWriter *progressWriter,
                    bool testMode,
@@ -0,0 +1,127 @@
+#include "TypeTable.h"
+
+#include "ArrayType.h"
+#include "ObjectPointerType.h"
+#include "SimpleType.h"
+#include "utils/HashUtils.h"
+
+#include <mutex>
+#include <tuple>
+
+namespace types {
+    namespace {
+        auto kindKey(const AbstractType &kind) {
+            uint64_t id = 0;
+            bool unnamed = false;
+            bool constQualified = false;
+            bool complete = false;
+            int referenceType = 0;
+            if (auto simpleType = dynamic_cast<const SimpleType *>(&kind)) {
+                id = simpleType->getId();
+                unnamed = simpleType->isUnnamed();
+                constQualified = simpleType->isConstQualified();
+                referenceType = simpleType->isLValue() ? 1 : (simpleType->isRValue() ? 2 : 0);
+            } else if (auto pointerType = dynamic_cast<const ObjectPointerType *>(&kind)) {
+                constQualified = pointerType->isConstQualified();
+            } else if (auto arrayType = dynamic_cast<const ArrayType *>(&kind)) {
+                complete = arrayType->isComplete();
+            }
+            return std::make_tuple(static_cast<int>(kind.getKind()), kind.getSize(), id, unnamed,
+                                   constQualified, complete, referenceType);
+        }
+    }
+
+    TypeTable &TypeTable::getInstance() {
+        // never destroyed, since types in static storage may outlive it
+        static auto *instance = new TypeTable();
+        return *instance;
+    }
+
+    TypeTable::TypeTable() {
+        empty = intern(TypeData{});
+    }
+
+    std::shared_ptr<const TypeData> TypeTable::intern(TypeData data) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = entries.find(&data);
+            if (it != entries.end()) {
+                if (auto entry = it->second.lock()) {
+                    return entry;
+                }
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = entries.find(&data);
+        if (it != entries.end()) {
+            if (auto entry = it->second.lock()) {
+                return entry;
+            }
+            // the last type of the entry is being destroyed, so it is replaced by a new one
+            entries.erase(it);
+        }
+        auto [nameIt, nameInserted] = names.try_emplace(data.type, NameEntry{ nextNameHandle, 0 });
+        if (nameInserted) {
+            ++nextNameHandle;
+        }
+        ++nameIt->second.entriesCount;
+        data.nameHandle = nameIt->second.handle;
+        data.handle = nextHandle++;
+        std::shared_ptr<const TypeData> entry(new TypeData(std::move(data)),
+                                              [this](const TypeData *removed) {
+                                                  remove(removed);
+                                                  delete removed;
+                                              });
+        entries.emplace(entry.get(), entry);
+        return entry;
+    }
+
+    void TypeTable::remove(const TypeData *data) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = entries.find(data);
+        if (it != entries.end() && it->first == data) {
+            entries.erase(it);
+        }
+        auto nameIt = names.find(data->type);
+        if (--nameIt->second.entriesCount == 0) {
+            names.erase(nameIt);
+        }
+    }
+
+    const std::shared_ptr<const TypeData> &TypeTable::getEmpty() const {
+        return empty;
+    }
+
+    size_t TypeTable::size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return entries.size();
+    }
+
+    std::size_t TypeTable::TypeDataHash::operator()(const TypeData *data) const {
+        std::size_t seed = 0;
+        HashUtils::hashCombine(seed, data->type, data->baseType, data->usedType, data->dimension,
+                               data->typeId.value_or(0), data->baseTypeId.value_or(0),
+                               data->kinds.size());
+        for (const auto &kind : data->kinds) {
+            auto [kindType, size, id, unnamed, constQualified, complete, referenceType] = kindKey(*kind);
+            HashUtils::hashCombine(seed, kindType, size, id, unnamed, constQualified, complete,
+                                   referenceType);
+        }
+        return seed;
+    }
+
+    bool TypeTable::TypeDataEqual::operator()(const TypeData *lhs, const TypeData *rhs) const {
+        if (lhs->type != rhs->type || lhs->baseType != rhs->baseType ||
+            lhs->usedType != rhs->usedType || lhs->dimension != rhs->dimension ||
+            lhs->typeId != rhs->typeId || lhs->baseTypeId != rhs->baseTypeId ||
+            lhs->kinds.size() != rhs->kinds.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < lhs->kinds.size(); ++i) {
+            if (kindKey(*lhs->kinds[i]) != kindKey(*rhs->kinds[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef UNITTESTBOT_TYPETABLE_H
+#define UNITTESTBOT_TYPETABLE_H
+
+#include "AbstractType.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace types {
+    using TypeHandle = uint32_t;
+
+    /**
+     * Immutable contents of types::Type. Every distinct value is stored in TypeTable exactly once.
+     */
+    struct TypeData {
+        std::string type;
+        std::string baseType;
+        std::string usedType;
+        std::vector<std::shared_ptr<AbstractType>> kinds;
+        size_t dimension = 0;
+        std::optional<uint64_t> typeId;
+        std::optional<uint64_t> baseTypeId;
+        // id of `type`, shared by all live entries with the same type name
+        TypeHandle nameHandle = 0;
+        // id of the entry, equal entries alive at the same time have equal handles
+        TypeHandle handle = 0;
+    };
+
+    /**
+     * Process-wide hash-consed storage of types. An entry lives while some types::Type refers
+     * to it and is removed with the last one, so the table holds only the types of requests
+     * in progress and of their results. Entries are immutable and are read without locking.
+     *
+     * Handles are never reused, so a handle of a removed entry can't match another type in
+     * caches keyed by handles. As handles grow during the server lifetime, such caches are
+     * hash maps rather than vectors indexed by handles.
+     */
+    class TypeTable {
+    public:
+        static TypeTable &getInstance();
+
+        TypeTable(const TypeTable &) = delete;
+        TypeTable &operator=(const TypeTable &) = delete;
+
+        /**
+         * Returns the entry equal to data, creating it if necessary.
+         * Fields nameHandle and handle of data are ignored and filled by the table.
+         */
+        std::shared_ptr<const TypeData> intern(TypeData data);
+
+        /**
+         * Entry of a default constructed types::Type, it is never removed.
+         */
+        [[nodiscard]] const std::shared_ptr<const TypeData> &getEmpty() const;
+
+        /**
+         * Number of live entries.
+         */
+        [[nodiscard]] size_t size() const;
+
+    private:
+        TypeTable();
+
+        struct TypeDataHash {
+            std::size_t operator()(const TypeData *data) const;
+        };
+
+        struct TypeDataEqual {
+            bool operator()(const TypeData *lhs, const TypeData *rhs) const;
+        };
+
+        struct NameEntry {
+            TypeHandle handle;
+            size_t entriesCount;
+        };
+
+        mutable std::shared_mutex mutex;
+        std::unordered_map<const TypeData *, std::weak_ptr<const TypeData>, TypeDataHash,
+                           TypeDataEqual>
+            entries;
+        std::unordered_map<std::string, NameEntry> names;
+        TypeHandle nextHandle = 0;
+        TypeHandle nextNameHandle = 0;
+        std::shared_ptr<const TypeData> empty;
+
+        /**
+         * Called when the last type that refers to data is destroyed.
+         */
+        void remove(const TypeData *data);
+    };
+}
+
+#endif // UNITTESTBOT_TYPETABLE_H
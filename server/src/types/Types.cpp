@@ -11,24 +11,45 @@
 /*
  * class Type
  */
-types::Type::Type(clang::QualType qualType, TypeName usedTypeName, const clang::SourceManager &sourceManager): mUsedType(std::move(usedTypeName)) {
+types::Type::Type() : data(TypeTable::getInstance().getEmpty()) {
+}
+
+types::Type::Type(TypeData typeData) : data(TypeTable::getInstance().intern(std::move(typeData))) {
+}
+
+namespace {
+    size_t getDimension(const std::vector<types::Kind> &kinds) {
+        size_t dimension = 0;
+        while (dimension + 1 < kinds.size() &&
+               (kinds[dimension]->getKind() == AbstractType::OBJECT_POINTER ||
+                kinds[dimension]->getKind() == AbstractType::ARRAY)) {
+            ++dimension;
+        }
+        return dimension;
+    }
+}
+
+types::Type::Type(clang::QualType qualType, TypeName usedTypeName, const clang::SourceManager &sourceManager) {
+    TypeData typeData;
+    typeData.usedType = std::move(usedTypeName);
     clang::QualType canonicalType = qualType.getCanonicalType();
     auto pp = clang::PrintingPolicy(clang::LangOptions());
     fs::path sourceFilePath = sourceManager.getFileEntryForID(sourceManager.getMainFileID())->tryGetRealPathName().str();
     if (Paths::getSourceLanguage(sourceFilePath) == utbot::Language::CXX) {
         pp.adjustForCPlusPlus();
     }
-    mType = canonicalType.getNonReferenceType().getUnqualifiedType().getAsString(pp);
+    typeData.type = canonicalType.getNonReferenceType().getUnqualifiedType().getAsString(pp);
     TypeVisitor visitor;
     visitor.TraverseType(qualType);
-    mKinds = visitor.getKinds();
-    dimension = getDimension();
-    mBaseType = visitor.getTypes()[dimension];
-    mTypeId = getIdFromCanonicalType(canonicalType);
-    AbstractType *baseType = mKinds[dimension].get();
+    typeData.kinds = visitor.getKinds();
+    typeData.dimension = ::getDimension(typeData.kinds);
+    typeData.baseType = visitor.getTypes()[typeData.dimension];
+    typeData.typeId = getIdFromCanonicalType(canonicalType);
+    AbstractType *baseType = typeData.kinds[typeData.dimension].get();
     if (auto simpleType = dynamic_cast<SimpleType*>(baseType)) {
-        mBaseTypeId = simpleType->getId();
+        typeData.baseTypeId = simpleType->getId();
     }
+    *this = Type(std::move(typeData));
 }
 
 uint64_t types::Type::getIdFromCanonicalType(clang::QualType canonicalType) {
@@ -48,19 +69,27 @@ uint64_t types::Type::getIdFromCanonicalType(clang::QualType canonicalType) {
     }
 }
 
-types::Type::Type(const types::TypeName& type, size_t pointersNum) {
-    if (pointersNum > 0) {
-        mType = type + " " + std::string(pointersNum, '*');
-    } else {
-        mType = type;
-    }
-    mUsedType = mType;
-    dimension = pointersNum;
-    mBaseType = type;
-    for (size_t i = 0; i < pointersNum; ++i) {
-        mKinds.push_back(std::make_shared<ObjectPointerType>(false));
+namespace {
+    types::TypeData simpleTypeData(const types::TypeName &type, size_t pointersNum) {
+        types::TypeData typeData;
+        if (pointersNum > 0) {
+            typeData.type = type + " " + std::string(pointersNum, '*');
+        } else {
+            typeData.type = type;
+        }
+        typeData.usedType = typeData.type;
+        typeData.dimension = pointersNum;
+        typeData.baseType = type;
+        for (size_t i = 0; i < pointersNum; ++i) {
+            typeData.kinds.push_back(std::make_shared<ObjectPointerType>(false));
+        }
+        typeData.kinds.push_back(std::make_shared<SimpleType>(0, false, false, SimpleType::ReferenceType::NotReference));
+        return typeData;
     }
-    mKinds.push_back(std::make_shared<SimpleType>(0, false, false, SimpleType::ReferenceType::NotReference));
+}
+
+types::Type::Type(const types::TypeName& type, size_t pointersNum)
+    : Type(simpleTypeData(type, pointersNum)) {
 }
 
 types::Type types::Type::createSimpleTypeFromName(const types::TypeName& type, size_t pointersNum) {
@@ -68,48 +97,50 @@ types::Type types::Type::createSimpleTypeFromName(const types::TypeName& type, s
 }
 
 types::Type types::Type::createConstTypeFromName(const types::TypeName& type, size_t pointersNum) {
-    auto res = createSimpleTypeFromName(type, pointersNum);
-    res.mType = "const " + res.mType;
-    res.mUsedType = res.mType;
-    return res;
+    TypeData typeData = simpleTypeData(type, pointersNum);
+    typeData.type = "const " + typeData.type;
+    typeData.usedType = typeData.type;
+    return Type(std::move(typeData));
 }
 
 types::Type types::Type::createArray(const types::Type &type) {
-    Type res;
-    res.mType = type.typeName() + "*";
-    res.mUsedType = res.mType;
-    res.mBaseType = type.baseType();
-    res.mKinds = type.mKinds;
-    res.mKinds.insert(res.mKinds.begin(), std::shared_ptr<AbstractType>(new ArrayType(
+    TypeData typeData;
+    typeData.type = type.typeName() + "*";
+    typeData.usedType = typeData.type;
+    typeData.baseType = type.baseType();
+    typeData.kinds = type.kinds();
+    typeData.kinds.insert(typeData.kinds.begin(), std::shared_ptr<AbstractType>(new ArrayType(
         TypesHandler::getElementsNumberInPointerOneDim(PointerUsage::PARAMETER), false)));
-    res.dimension = type.dimension + 1;
-    res.mTypeId = 0;
-    res.mBaseTypeId = type.mBaseTypeId;
+    typeData.dimension = type.data->dimension + 1;
+    typeData.typeId = 0;
+    typeData.baseTypeId = type.data->baseTypeId;
+    Type res(std::move(typeData));
     res.maybeArray = true;
     return res;
 }
 
-types::TypeName types::Type::typeName() const {
-    return mType;
+const types::TypeName &types::Type::typeName() const {
+    return data->type;
 }
 
-types::TypeName types::Type::baseType() const {
-    return mBaseType;
+const types::TypeName &types::Type::baseType() const {
+    return data->baseType;
 }
 
-types::TypeName types::Type::usedType() const {
-    return mUsedType;
+const types::TypeName &types::Type::usedType() const {
+    return data->usedType;
 }
 
 types::Type types::Type::baseTypeObj(size_t depth) const {
-    auto type = *this;
-    type.mType = mBaseType;
-    type.mBaseType = type.mType;
-    type.mUsedType = type.mType;
-    type.mKinds.erase(type.mKinds.begin(), type.mKinds.begin() + depth);
-    type.dimension = type.getDimension();
-    type.mTypeId = mBaseTypeId;
-    type.mBaseTypeId = {};
+    TypeData typeData;
+    typeData.type = data->baseType;
+    typeData.baseType = typeData.type;
+    typeData.usedType = typeData.type;
+    typeData.kinds.assign(data->kinds.begin() + depth, data->kinds.end());
+    typeData.dimension = ::getDimension(typeData.kinds);
+    typeData.typeId = data->baseTypeId;
+    Type type(std::move(typeData));
+    type.maybeArray = maybeArray;
     return type;
 }
 
@@ -117,17 +148,17 @@ types::Type types::Type::baseTypeObj() const {
     return baseTypeObj(getDimension());
 }
 
-std::string types::Type::mTypeName() const {
-    return this->mType;
+const std::string &types::Type::mTypeName() const {
+    return data->type;
 }
 
 size_t types::Type::getDimension() const {
-    // usage doesn't matter here
-    return arraysSizes(PointerUsage::PARAMETER).size();
+    // same as arraysSizes(...).size(), usage doesn't matter here
+    return ::getDimension(data->kinds);
 }
 
 std::optional<uint64_t> types::Type::getBaseTypeId() const {
-    return mBaseTypeId;
+    return data->baseTypeId;
 }
 
 bool types::Type::maybeJustPointer() const {
@@ -159,7 +190,7 @@ size_t types::Type::countReturnPointers(bool decrementIfArray) const {
 }
 
 const std::vector<std::shared_ptr<AbstractType>> &types::Type::kinds() const {
-    return mKinds;
+    return data->kinds;
 }
 
 std::vector<size_t> types::Type::arraysSizes(PointerUsage usage) const {
@@ -200,8 +231,8 @@ std::vector<std::shared_ptr<AbstractType>> types::Type::pointerArrayKinds() cons
 
     size_t i = 0;
     while (i < kinds().size() - 1 &&
-        (mKinds[i]->getKind() == AbstractType::OBJECT_POINTER || mKinds[i]->getKind() == AbstractType::ARRAY)) {
-        res.push_back(mKinds[i]);
+        (kinds()[i]->getKind() == AbstractType::OBJECT_POINTER || kinds()[i]->getKind() == AbstractType::ARRAY)) {
+        res.push_back(kinds()[i]);
         ++i;
     }
 
@@ -213,37 +244,37 @@ bool types::Type::isArrayCandidate() const {
 }
 
 bool types::Type::isObjectPointer() const {
-    return mKinds.front()->getKind() == AbstractType::OBJECT_POINTER;
+    return kinds().front()->getKind() == AbstractType::OBJECT_POINTER;
 }
 
 bool types::Type::isArray() const {
-    return mKinds.front()->getKind() == AbstractType::ARRAY;
+    return kinds().front()->getKind() == AbstractType::ARRAY;
 }
 
 bool types::Type::isPointerToFunction() const {
-    return mKinds.front()->getKind() == AbstractType::FUNCTION_POINTER;
+    return kinds().front()->getKind() == AbstractType::FUNCTION_POINTER;
 }
 
 bool types::Type::isArrayOfPointersToFunction() const {
-    return mKinds.size() > 1 &&
-           mKinds[0]->getKind() == AbstractType::OBJECT_POINTER &&
-           mKinds[1]->getKind() == AbstractType::FUNCTION_POINTER;
+    return kinds().size() > 1 &&
+           kinds()[0]->getKind() == AbstractType::OBJECT_POINTER &&
+           kinds()[1]->getKind() == AbstractType::FUNCTION_POINTER;
 }
 
 bool types::Type::isSimple() const {
-    return mKinds.front()->getKind() == AbstractType::SIMPLE;
+    return kinds().front()->getKind() == AbstractType::SIMPLE;
 }
 
 bool types::Type::isUnnamed() const {
-    return isSimple() && dynamic_cast<SimpleType *>(mKinds.front().get())->isUnnamed();
+    return isSimple() && dynamic_cast<SimpleType *>(kinds().front().get())->isUnnamed();
 }
 
 bool types::Type::isLValueReference() const {
-    return isSimple() && dynamic_cast<SimpleType *>(mKinds.front().get())->isLValue();
+    return isSimple() && dynamic_cast<SimpleType *>(kinds().front().get())->isLValue();
 }
 
 bool types::Type::isConstQualified() const {
-    return isSimple() && dynamic_cast<SimpleType *>(mKinds.front().get())->isConstQualified();
+    return isSimple() && dynamic_cast<SimpleType *>(kinds().front().get())->isConstQualified();
 }
 
 static const types::TypeName MINIMAL_SCALAR_TYPE = "unsigned char";
@@ -296,7 +327,7 @@ bool types::Type::isPointerToArray() const {
 }
 
 bool types::Type::isConstQualifiedValue() const {
-    for(const auto& kind : mKinds) {
+    for(const auto& kind : kinds()) {
         if(kind->getKind() == AbstractType::SIMPLE) {
             if(dynamic_cast<SimpleType*>(kind.get())->isConstQualified()) {
                 return true;
@@ -321,7 +352,7 @@ bool types::Type::isTypeContainsPointer() const {
 }
 
 bool types::Type::isTypeContainsFunctionPointer() const {
-    for (const auto &kind : mKinds) {
+    for (const auto &kind : kinds()) {
         if (kind->getKind() == AbstractType::FUNCTION_POINTER) {
             return true;
         }
@@ -345,20 +376,24 @@ bool types::Type::isOneDimensionPointer() const {
 }
 
 types::Type types::Type::arrayClone(PointerUsage usage, size_t pointerSize) const {
-    Type t = *this;
-    t.mKinds[0] = std::make_shared<ArrayType>(TypesHandler::getElementsNumberInPointerOneDim(usage, pointerSize), true);
+    TypeData typeData = *data;
+    typeData.kinds[0] = std::make_shared<ArrayType>(TypesHandler::getElementsNumberInPointerOneDim(usage, pointerSize), true);
+    Type t(std::move(typeData));
+    t.maybeArray = maybeArray;
     return t;
 }
 
 types::Type types::Type::arrayCloneMultiDim(PointerUsage usage, std::vector<size_t> pointerSizes) const {
-    Type t = *this;
+    TypeData typeData = *data;
     for(size_t i = 0; i < pointerSizes.size(); ++i) {
-        if (t.mKinds[i]->getKind() == AbstractType::OBJECT_POINTER) {
-            t.mKinds[i] = std::make_shared<ArrayType>(
+        if (typeData.kinds[i]->getKind() == AbstractType::OBJECT_POINTER) {
+            typeData.kinds[i] = std::make_shared<ArrayType>(
                 TypesHandler::getElementsNumberInPointerMultiDim(usage, pointerSizes[i]),
                 true);
         }
     }
+    Type t(std::move(typeData));
+    t.maybeArray = maybeArray;
     return t;
 }
 
@@ -377,11 +412,15 @@ types::Type types::Type::arrayCloneMultiDim(PointerUsage usage) const {
 }
 
 uint64_t types::Type::getId() const {
-    return mTypeId.value_or(0);
+    return data->typeId.value_or(0);
 }
 
 void types::Type::replaceUsedType(const types::TypeName &newUsedType) {
-    mUsedType = newUsedType;
+    TypeData typeData = *data;
+    typeData.usedType = newUsedType;
+    bool wasMaybeArray = maybeArray;
+    *this = Type(std::move(typeData));
+    maybeArray = wasMaybeArray;
 }
 
 /*
@@ -519,33 +558,33 @@ bool types::TypesHandler::skipTypeInReturn(const Type& type) {
 /*
  * Get struct information
  */
-types::StructInfo types::TypesHandler::getStructInfo(const Type &type) const {
+const types::StructInfo &types::TypesHandler::getStructInfo(const Type &type) const {
     return getStructInfo(type.getId());
 }
 
-types::StructInfo types::TypesHandler::getStructInfo(uint64_t id) const {
+const types::StructInfo &types::TypesHandler::getStructInfo(uint64_t id) const {
     return typeFromMap<StructInfo>(id, typeMaps.structs);
 }
 
 /*
  * Get enum information
  */
-types::EnumInfo types::TypesHandler::getEnumInfo(const types::Type &type) const {
+const types::EnumInfo &types::TypesHandler::getEnumInfo(const types::Type &type) const {
     return getEnumInfo(type.getId());
 }
 
-types::EnumInfo types::TypesHandler::getEnumInfo(uint64_t id) const {
+const types::EnumInfo &types::TypesHandler::getEnumInfo(uint64_t id) const {
     return typeFromMap<EnumInfo>(id, typeMaps.enums);
 }
 
 /*
  * Get union information
  */
-types::UnionInfo types::TypesHandler::getUnionInfo(const types::Type &type) const {
+const types::UnionInfo &types::TypesHandler::getUnionInfo(const types::Type &type) const {
     return getUnionInfo(type.getId());
 }
 
-types::UnionInfo types::TypesHandler::getUnionInfo(uint64_t id) const {
+const types::UnionInfo &types::TypesHandler::getUnionInfo(uint64_t id) const {
     return typeFromMap<UnionInfo>(id, typeMaps.unions);
 }
 
@@ -850,13 +889,18 @@ std::string types::TypesHandler::cBoolToCpp(const types::TypeName &type) {
 
 types::TypeSupport
 types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int depth) const {
-    auto hashArgument = IsSupportedTypeArguments(type.typeName(), usage);
-    auto writtenValue = isSupportedTypeHash.find(hashArgument);
-    if (writtenValue != isSupportedTypeHash.end()) {
-        return writtenValue->second;
+    // base types of nested pointers are not checked, so their verdicts depend on depth
+    bool cacheable = !(type.isObjectPointer() && depth > 0);
+    size_t hashIndex = isSupportedTypeIndex(type, usage);
+    if (cacheable) {
+        auto it = isSupportedTypeHash.find(hashIndex);
+        if (it != isSupportedTypeHash.end()) {
+            return it->second;
+        }
     }
-    recursiveCheckStarted.insert(type.typeName());
-    using PredicateWithReason = std::pair<std::string, std::function<bool(Type, TypeUsage)>>;
+    TypeHandle nameHandle = type.getNameHandle();
+    recursiveCheckStarted.insert(nameHandle);
+    using PredicateWithReason = std::pair<std::string, std::function<bool(const Type &, TypeUsage)>>;
     std::vector<PredicateWithReason> unsupportedPredicates = {
         {
             "Type is unknown",
@@ -874,7 +918,7 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
             "Type has flexible array member",
             [&](const Type &type, TypeUsage usage) {
               if (isStruct(type)) {
-                  auto structInfo = getStructInfo(type);
+                  const auto &structInfo = getStructInfo(type);
                   if (structInfo.fields.empty()) {
                       return false;
                   }
@@ -895,11 +939,11 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
               };
 
               if (isUnion(type)) {
-                  auto unionInfo = getUnionInfo(type);
+                  const auto &unionInfo = getUnionInfo(type);
                   return unsupportedFields(unionInfo.fields);
               }
               if (isStruct(type)) {
-                  auto structInfo = getStructInfo(type);
+                  const auto &structInfo = getStructInfo(type);
                   return !structInfo.hasUnnamedFields && unsupportedFields(structInfo.fields);
               }
               return false;
@@ -943,7 +987,8 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
             [&](const Type &type, TypeUsage usage) {
               auto unsupportedFields = [&](const std::vector<types::Field> &fields) {
                 return std::any_of(fields.begin(), fields.end(), [&](const types::Field &field) {
-                  if (!CollectionUtils::contains(recursiveCheckStarted, field.type.typeName())) {
+                  if (!CollectionUtils::contains(recursiveCheckStarted,
+                                                 field.type.getNameHandle())) {
                       if (field.type.isObjectPointer()) {
                           return false;
                       }
@@ -955,12 +1000,12 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
                 });
               };
               if (isStruct(type)) {
-                  auto structInfo = getStructInfo(type);
+                  const auto &structInfo = getStructInfo(type);
                   return !structInfo.hasUnnamedFields && unsupportedFields(structInfo.fields);
               }
 
               if (isUnion(type)) {
-                  auto unionInfo = getUnionInfo(type);
+                  const auto &unionInfo = getUnionInfo(type);
                   return unsupportedFields(unionInfo.fields);
               }
               return false;
@@ -980,30 +1025,22 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
             } }
     };
 
+    types::TypeSupport result = {true, ""};
     for (const auto &[reason, predicate]: unsupportedPredicates) {
         if (predicate(type, usage)) {
-            recursiveCheckStarted.erase(type.typeName());
-            return {false, reason};
+            result = {false, reason};
+            break;
         }
     }
-    recursiveCheckStarted.erase(type.typeName());
-    types::TypeSupport result = {true, ""};
-    isSupportedTypeHash[IsSupportedTypeArguments(hashArgument)] = result;
+    recursiveCheckStarted.erase(nameHandle);
+    if (cacheable) {
+        isSupportedTypeHash.insert_or_assign(hashIndex, result);
+    }
     return result;
 }
 
-
-types::TypesHandler::IsSupportedTypeArguments::IsSupportedTypeArguments(types::TypeName typeName,
-                                                                        types::TypeUsage usage)
-    : typeName(std::move(typeName)), usage(usage) {
-}
-
-bool types::TypesHandler::IsSupportedTypeArguments::operator==(const types::TypesHandler::IsSupportedTypeArguments &other) const {
-    return typeName == other.typeName && usage == other.usage;
-}
-
-std::size_t types::TypesHandler::IsSupportedTypeArgumentsHash::operator()(const types::TypesHandler::IsSupportedTypeArguments &args) const {
-    return fs::hash_value(args.typeName + std::to_string((int)args.usage));
+size_t types::TypesHandler::isSupportedTypeIndex(const types::Type &type, types::TypeUsage usage) {
+    return type.getHandle() * TYPE_USAGES_COUNT + static_cast<size_t>(usage);
 }
 
 types::Type types::TypesHandler::getReturnTypeToCheck(const types::Type &returnType) const {
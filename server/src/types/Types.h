@@ -3,6 +3,7 @@
 
 #include "AbstractType.h"
 #include "Language.h"
+#include "TypeTable.h"
 #include "exceptions/NoSuchTypeException.h"
 #include "utils/CollectionUtils.h"
 #include "utils/ExecUtils.h"
@@ -10,7 +11,6 @@
 
 #include <clang/AST/Type.h>
 #include <protobuf/util.pb.h>
-#include <tsl/ordered_set.h>
 
 #include <string>
 #include <unordered_map>
@@ -25,27 +25,31 @@ namespace types {
     enum class PointerUsage;
     enum class ReferenceType;
 
+    /**
+     * Lightweight reference to an immutable entry of TypeTable, the entry lives while some type
+     * refers to it. Copying, hashing and comparison of types are O(1) and don't allocate.
+     */
     class Type {
     public:
-        Type() = default;
+        Type();
 
         explicit Type(clang::QualType qualType, TypeName usedTypeName, const clang::SourceManager &sourceManager);
 
         /**
          * @return string representation of this type.
          */
-        [[nodiscard]] TypeName typeName() const;
+        [[nodiscard]] const TypeName &typeName() const;
 
         /**
          * @return string representation of this type without qualifiers, references and arrays.
          */
-        [[nodiscard]] TypeName baseType() const;
+        [[nodiscard]] const TypeName &baseType() const;
 
         /**
          * Returns string representation of this type that was actually used in source code.
          * @return typename that was used in code.
          */
-        [[nodiscard]] TypeName usedType() const;
+        [[nodiscard]] const TypeName &usedType() const;
 
         /**
          * Returns vector that stores information about type:
@@ -86,7 +90,7 @@ namespace types {
         /**
          * @return String mType
          */
-        [[nodiscard]] std::string mTypeName() const;
+        [[nodiscard]] const std::string &mTypeName() const;
 
 
         /**
@@ -237,17 +241,36 @@ namespace types {
 
         static const size_t symStdinSize = 64;
         static const std::string &getStdinParamName();
+        /**
+         * @return handle of this type in TypeTable. Equal types have equal handles.
+         */
+        [[nodiscard]] TypeHandle getHandle() const {
+            return data->handle;
+        }
+
+        /**
+         * @return dense id of typeName(). Types with equal names have equal name handles.
+         */
+        [[nodiscard]] TypeHandle getNameHandle() const {
+            return data->nameHandle;
+        }
+
+        bool operator==(const Type &other) const {
+            return data == other.data && maybeArray == other.maybeArray;
+        }
+
+        bool operator!=(const Type &other) const {
+            return !(*this == other);
+        }
+
     private:
 
         explicit Type(const TypeName& type, size_t pointersNum=0);
 
-        TypeName mType;
-        TypeName mBaseType;
-        TypeName mUsedType;
-        std::vector<Kind> mKinds;
-        size_t dimension;
-        std::optional<uint64_t> mTypeId;
-        std::optional<uint64_t> mBaseTypeId;
+        explicit Type(TypeData typeData);
+
+        // keeps the entry in TypeTable alive
+        std::shared_ptr<const TypeData> data;
 
     public:
         uint64_t getId() const;
@@ -497,7 +520,8 @@ namespace types {
         std::string getDefaultValueForType(const Type&, utbot::Language language) const;
 
         /**
-         * Checks whether given type is supported.
+         * Checks whether given type is supported. Verdicts are memoized for the lifetime
+         * of the handler, so closures of types shared by many functions are checked once.
          * @return TypeSupport structs that contains information regarding type support.
          */
         TypeSupport isSupportedType(const Type &type, TypeUsage usage = TypeUsage::ALL, int depth = 0) const;
@@ -512,31 +536,32 @@ namespace types {
         /**
          * Returns StructInfo by given struct name.
          * For safe usage, please use isStruct(..) before calling getStructInfo(..).
+         * Infos are shared by all users of the handler, so they are not copied.
          * @return StructInfo for given struct.
          */
-        StructInfo getStructInfo(const Type&) const;
+        const StructInfo &getStructInfo(const Type&) const;
 
         /**
          * Returns EnumInfo bu given enum name.
          * Fir safe usage, please use isEnum(..) before calling getEnumInfo(..).
          * @return EnumInfo for given enum.
          */
-        EnumInfo getEnumInfo(const Type&) const;
+        const EnumInfo &getEnumInfo(const Type&) const;
 
         /**
          * Returns UnionInfo by given union name.
          * For safe usage, please use isUnion(..) before calling getUnionInfo(..).
          * @return UnionInfo for given union.
          */
-        UnionInfo getUnionInfo(const Type&) const;
+        const UnionInfo &getUnionInfo(const Type&) const;
 
         bool isStruct(uint64_t id) const;
         bool isEnum(uint64_t id) const;
         bool isUnion(uint64_t id) const;
 
-        [[nodiscard]] StructInfo getStructInfo(uint64_t id) const;
-        [[nodiscard]] EnumInfo getEnumInfo(uint64_t id) const;
-        [[nodiscard]] UnionInfo getUnionInfo(uint64_t id) const;
+        [[nodiscard]] const StructInfo &getStructInfo(uint64_t id) const;
+        [[nodiscard]] const EnumInfo &getEnumInfo(uint64_t id) const;
+        [[nodiscard]] const UnionInfo &getUnionInfo(uint64_t id) const;
 
         /**
          * Returns map of constraints for every supported primitive type, that might be used in
@@ -620,24 +645,20 @@ namespace types {
          */
         static std::string removeArrayBrackets(TypeName type);
 
-        struct IsSupportedTypeArguments {
-            IsSupportedTypeArguments(TypeName typeName, TypeUsage usage);
-            const TypeName typeName;
-            types::TypeUsage usage;
-            bool operator==(const IsSupportedTypeArguments & other) const;
-        };
-        struct IsSupportedTypeArgumentsHash {
-            std::size_t operator()(const IsSupportedTypeArguments &args) const;
-        };
+        static constexpr size_t TYPE_USAGES_COUNT = 3;
+
+        static size_t isSupportedTypeIndex(const Type &type, TypeUsage usage);
 
     private:
         TypeMaps &typeMaps;
         SizeContext sizeContext;
-        mutable tsl::ordered_set<TypeName> recursiveCheckStarted{};
-        mutable std::unordered_map<IsSupportedTypeArguments,
-                                   types::TypeSupport,
-                                   IsSupportedTypeArgumentsHash>
-            isSupportedTypeHash{};
+        // name handles of types whose check is in progress
+        mutable std::unordered_set<TypeHandle> recursiveCheckStarted{};
+        /*
+         * Keyed by handles of whole types, since qualifiers and pointers change verdicts.
+         * Handles are global, so only the types checked by this handler are stored.
+         */
+        mutable std::unordered_map<size_t, types::TypeSupport> isSupportedTypeHash{};
 
         static std::unordered_map<TypeName, size_t> integerTypesToSizes() noexcept;
         static std::unordered_map<TypeName, size_t> floatingPointTypesToSizes() noexcept;
@@ -653,9 +674,10 @@ namespace types {
         }
 
         template<typename T>
-        T typeFromMap(uint64_t id, const std::unordered_map<uint64_t, T>& someMap) const {
-            if (CollectionUtils::containsKey(someMap, id)) {
-                return someMap.at(id);
+        const T &typeFromMap(uint64_t id, const std::unordered_map<uint64_t, T>& someMap) const {
+            auto it = someMap.find(id);
+            if (it != someMap.end()) {
+                return it->second;
             }
             throw NoSuchTypeException(StringUtils::stringFormat("Type with id=%llu can't be found.", id));
         }
@@ -681,4 +703,11 @@ namespace types {
 
 }
 
+template<>
+struct std::hash<types::Type> {
+    std::size_t operator()(const types::Type &type) const noexcept {
+        return std::hash<types::TypeHandle>()(type.getHandle());
+    }
+};
+
 #endif //UNITTESTBOT_TYPES_H
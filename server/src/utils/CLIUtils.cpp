@@ -186,6 +186,18 @@ void CLIUtils::parse(int argc, char **argv, CLI::App &app) {
         }
 
     } else if (app.got_subcommand(mainCommands.getRunTestsCommand())) {
+        // coverage-only run doesn't report results, so it can't skip coverage or rerun failed tests
+        if (runTestCommandsOptions.coverageOnly() && !runTestCommandsOptions.withCoverage()) {
+            throw CLI::ValidationError("--coverage-only",
+                                       "can't be used with --no-coverage, coverage is the only "
+                                       "output of a coverage-only run");
+        }
+        if (runTestCommandsOptions.coverageOnly() &&
+            runTestCommandsOptions.sanitizeFailedTestsOnly()) {
+            throw CLI::ValidationError("--coverage-only",
+                                       "can't be used with --sanitize-failed-only, tests are not "
+                                       "checked for failures in a coverage-only run");
+        }
         auto projectContext = createProjectContextByOptions(projectRunContext);
         auto settingsContext = createSettingsContextByOptions(settingsRunContext);
         if (runCommands.gotRunTestCommand()) {
@@ -194,6 +206,9 @@ void CLIUtils::parse(int argc, char **argv, CLI::App &app) {
                 runTestCommandsOptions.getTestName());
             auto coverageAndResultRequest = GrpcUtils::createCoverageAndResultRequest(
                 std::move(projectContext), std::move(testFilter));
+            coverageAndResultRequest->set_sanitizefailedtestsonly(
+                runTestCommandsOptions.sanitizeFailedTestsOnly());
+            coverageAndResultRequest->set_coverageonly(runTestCommandsOptions.coverageOnly());
             GenerationUtils::generateCoverageAndResultsAndWriteStatus(
                 std::move(coverageAndResultRequest), std::move(settingsContext),
                 runTestCommandsOptions.withCoverage());
@@ -202,6 +217,9 @@ void CLIUtils::parse(int argc, char **argv, CLI::App &app) {
                 GrpcUtils::createTestFilterForFile(runTestCommandsOptions.getFilePath());
             auto coverageAndResultRequest = GrpcUtils::createCoverageAndResultRequest(
                 std::move(projectContext), std::move(testFilter));
+            coverageAndResultRequest->set_sanitizefailedtestsonly(
+                runTestCommandsOptions.sanitizeFailedTestsOnly());
+            coverageAndResultRequest->set_coverageonly(runTestCommandsOptions.coverageOnly());
             GenerationUtils::generateCoverageAndResultsAndWriteStatus(
                 std::move(coverageAndResultRequest), std::move(settingsContext),
                 runTestCommandsOptions.withCoverage());
@@ -209,6 +227,9 @@ void CLIUtils::parse(int argc, char **argv, CLI::App &app) {
             auto testFilter = GrpcUtils::createTestFilterForProject();
             auto coverageAndResultRequest = GrpcUtils::createCoverageAndResultRequest(
                 std::move(projectContext), std::move(testFilter));
+            coverageAndResultRequest->set_sanitizefailedtestsonly(
+                runTestCommandsOptions.sanitizeFailedTestsOnly());
+            coverageAndResultRequest->set_coverageonly(runTestCommandsOptions.coverageOnly());
             GenerationUtils::generateCoverageAndResultsAndWriteStatus(
                 std::move(coverageAndResultRequest), std::move(settingsContext),
                 runTestCommandsOptions.withCoverage());
@@ -2,8 +2,7 @@
 
 namespace ExecUtils {
     void throwIfCancelled() {
-        auto context = RequestEnvironment::getServerContext();
-        if (context && context->IsCancelled()) {
+        if (RequestEnvironment::isCancelled()) {
             throw CancellationException();
         }
     }
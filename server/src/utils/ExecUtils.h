@@ -2,14 +2,19 @@
 #define UNITTESTBOT_EXECUTILS_H
 
 #include "CollectionUtils.h"
+#include "RequestEnvironment.h"
 #include "exceptions/CancellationException.h"
 #include "streams/IStreamWriter.h"
 #include "streams/ProgressWriter.h"
 #include "tasks/ShellExecTask.h"
 #include "ExecutionResult.h"
+#include "ThreadPool.h"
 
 #include <grpcpp/grpcpp.h>
 
+#include <atomic>
+#include <future>
+
 #include "utils/path/FileSystemPath.h"
 
 /**
@@ -51,6 +56,47 @@ namespace ExecUtils {
         }
     }
 
+    /**
+     * Same as doWorkWithProgress, but items are processed by threadsCount threads.
+     * Functor must be thread safe and items must stay alive until the function returns.
+     * Progress is reported from the calling thread. If an item fails or the request is
+     * cancelled, items that have not been started yet are skipped and the exception is
+     * rethrown after running ones are finished. Workers run with the request state of the
+     * calling thread.
+     */
+    template <typename Iterable, typename Functor>
+    void doWorkWithProgressInParallel(Iterable &&iterable,
+                                      ProgressWriter const *progressWriter,
+                                      std::string const &message,
+                                      size_t threadsCount,
+                                      Functor &&functor) {
+        size_t size = iterable.size();
+        progressWriter->writeProgress(message);
+        std::atomic_bool stopped = false;
+        auto requestState = RequestEnvironment::getThreadState();
+        std::vector<std::future<void>> results;
+        results.reserve(size);
+        ThreadPool pool(threadsCount);
+        for (auto &&it : iterable) {
+            results.push_back(pool.submit([&stopped, &functor, &it, &requestState]() {
+                RequestEnvironment::setThreadState(requestState);
+                if (!stopped && !RequestEnvironment::isCancelled()) {
+                    functor(it);
+                }
+            }));
+        }
+        try {
+            for (size_t step = 0; step < size; ++step) {
+                throwIfCancelled();
+                results[step].get();
+                progressWriter->writeProgress(message, (100.0 * step) / size);
+            }
+        } catch (...) {
+            stopped = true;
+            throw;
+        }
+    }
+
     void toCArgumentsPtr(std::vector<std::string> &argv,
                          std::vector<std::string> &envp,
                          std::vector<char *> &cargv,
@@ -2,11 +2,29 @@
 
 #include "exceptions/FileSystemException.h"
 
+#include <atomic>
+#include <filesystem>
 #include <fstream>
 #include <system_error>
+#include <unistd.h>
 #include "Paths.h"
 
 namespace FileSystemUtils {
+    std::optional<FileStamp> getFileStamp(const fs::path &path) {
+        std::filesystem::path filePath(path.string());
+        std::error_code error;
+        FileStamp stamp;
+        stamp.size = std::filesystem::file_size(filePath, error);
+        if (error) {
+            return std::nullopt;
+        }
+        stamp.modificationTime = std::filesystem::last_write_time(filePath, error);
+        if (error) {
+            return std::nullopt;
+        }
+        return stamp;
+    }
+
     void writeToFile(const fs::path &path, std::string_view text) {
         std::error_code e;
         auto parentPath = path.parent_path();
@@ -27,6 +45,41 @@ namespace FileSystemUtils {
         }
     }
 
+    void writeToFileAtomically(const fs::path &path, std::string_view text) {
+        static std::atomic<uint64_t> tempFilesCounter = 0;
+        fs::path tempPath = path.string() + "." + std::to_string(getpid()) + "." +
+                            std::to_string(tempFilesCounter++) + ".part";
+        try {
+            writeToFile(tempPath, text);
+            fs::rename(tempPath, path);
+        } catch (const fs::filesystem_error &e) {
+            fs::remove(tempPath);
+            throw FileSystemException("writing to file failed, file: " + path.string(), e);
+        } catch (...) {
+            fs::remove(tempPath);
+            throw;
+        }
+    }
+
+    bool writeToFileIfChanged(const fs::path &path, std::string_view text) {
+        if (hasContent(path, text)) {
+            return false;
+        }
+        writeToFile(path, text);
+        return true;
+    }
+
+    bool hasContent(const fs::path &path, std::string_view text) {
+        std::ifstream is(path, std::ios::binary | std::ios::ate);
+        if (!is || static_cast<size_t>(is.tellg()) != text.size()) {
+            return false;
+        }
+        is.seekg(0);
+        std::string content(text.size(), '\0');
+        is.read(content.data(), static_cast<std::streamsize>(content.size()));
+        return is && content == text;
+    }
+
     void removeAll(const fs::path &path) {
         if (path == fs::current_path().root_path()) {
             throw BaseException("Couldn't remove files from root directory.");
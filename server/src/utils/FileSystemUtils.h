@@ -2,12 +2,54 @@
 #define UNITTESTBOT_FILESYSTEMUTILS_H
 
 #include "utils/path/FileSystemPath.h"
+#include <cstdint>
+#include <optional>
 #include <string_view>
 #include <vector>
 
 namespace FileSystemUtils {
+    /**
+     * Size and modification time of a file. Caches compare stamps to skip reading files
+     * that were not changed since the cached data was built from them.
+     */
+    struct FileStamp {
+        uintmax_t size = 0;
+        fs::file_time_type modificationTime;
+
+        bool operator==(const FileStamp &other) const {
+            return size == other.size && modificationTime == other.modificationTime;
+        }
+
+        bool operator!=(const FileStamp &other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @return stamp of the file or std::nullopt if the file can't be accessed.
+     */
+    std::optional<FileStamp> getFileStamp(const fs::path &path);
+
     void writeToFile(fs::path const &path, std::string_view text);
 
+    /**
+     * Writes text to a temporary file next to path and renames it to path, so concurrent
+     * readers see either the old or the new content, never a partially written file.
+     */
+    void writeToFileAtomically(fs::path const &path, std::string_view text);
+
+    /**
+     * Writes text to the file unless the file already has exactly this content, so
+     * modification time of unchanged files is preserved.
+     * @return true if the file was written.
+     */
+    bool writeToFileIfChanged(fs::path const &path, std::string_view text);
+
+    /**
+     * @return true if the file exists and its content is equal to text.
+     */
+    bool hasContent(fs::path const &path, std::string_view text);
+
     void removeAll(const fs::path &path);
 
     void copyFile(const fs::path& from, const fs::path& to);
@@ -114,6 +114,19 @@ namespace GrpcUtils {
             return synchronizeCode(request.linerequest());
         }
     }
+
+    template <typename Request>
+    testsgen::TransferOptions transferOptions(Request const &request) {
+        if constexpr (std::is_same_v<Request, testsgen::ProjectRequest>) {
+            return request.transferoptions();
+        } else if constexpr (std::experimental::is_detected_v<has_projectrequest, Request>) {
+            return transferOptions(request.projectrequest());
+        } else if constexpr (std::experimental::is_detected_v<has_linerequest, Request>) {
+            return transferOptions(request.linerequest());
+        } else {
+            return {};
+        }
+    }
 }
 
 
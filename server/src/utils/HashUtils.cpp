@@ -4,7 +4,29 @@
 
 #include "Synchronizer.h"
 
+#include <cstdint>
+#include <cstdio>
+
 namespace HashUtils {
+    std::string contentHash(std::string_view content) {
+        ContentHasher hasher;
+        hasher.update(content);
+        return hasher.hexDigest();
+    }
+
+    void ContentHasher::update(std::string_view content) {
+        for (char c : content) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ULL;
+        }
+    }
+
+    std::string ContentHasher::hexDigest() const {
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+        return hex;
+    }
+
     std::size_t PathHash::operator()(const fs::path &path) const {
         return fs::hash_value(path);
     }
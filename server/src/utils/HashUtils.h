@@ -3,6 +3,10 @@
 
 #include "utils/path/FileSystemPath.h"
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+
 namespace tests {
     struct TestMethod;
 }
@@ -23,6 +27,26 @@ namespace HashUtils {
         (hashCombine(seed, std::forward<Rest>(rest)), ...);
     }
 
+    /**
+     * Hash of file content that is stable across runs and platforms, so that clients
+     * can compute it too: 64-bit FNV-1a printed as 16 lowercase hex digits.
+     */
+    std::string contentHash(std::string_view content);
+
+    /**
+     * Computes contentHash of a file written piece by piece, so that the file
+     * does not need to be read back to get its hash.
+     */
+    class ContentHasher {
+    public:
+        void update(std::string_view content);
+
+        [[nodiscard]] std::string hexDigest() const;
+
+    private:
+        uint64_t hash = 0xcbf29ce484222325ULL;
+    };
+
     struct PathHash {
         std::size_t operator()(const fs::path &path) const;
     };
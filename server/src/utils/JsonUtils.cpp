@@ -26,6 +26,6 @@ namespace JsonUtils {
     }
 
     void writeJsonToFile(const fs::path &jsonPath, const nlohmann::json &json) {
-        FileSystemUtils::writeToFile(jsonPath, json.dump(INDENT));
+        FileSystemUtils::writeToFileAtomically(jsonPath, json.dump(INDENT));
     }
 }
@@ -0,0 +1,70 @@
+#ifndef UNITTESTBOT_LRUCACHE_H
+#define UNITTESTBOT_LRUCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+
+/**
+ * Keeps at most capacity values and drops the least recently used one when a new value
+ * is put into the full cache. Lookups and insertions mark the value as used. The cache
+ * is not synchronized, callers guard it with their own mutex.
+ */
+template <typename Key, typename Value>
+class LRUCache {
+    using Entries = std::list<std::pair<Key, Value>>;
+
+    size_t capacity;
+    // the most recently used value is the first one
+    Entries entries;
+    std::map<Key, typename Entries::iterator> positions;
+
+    void use(typename Entries::iterator it) {
+        entries.splice(entries.begin(), entries, it);
+    }
+
+public:
+    explicit LRUCache(size_t capacity) : capacity(capacity) {
+    }
+
+    /**
+     * @return the value of the key or nullptr if there is none.
+     * Pointer is valid until the value is erased from the cache.
+     */
+    Value *get(const Key &key) {
+        auto it = positions.find(key);
+        if (it == positions.end()) {
+            return nullptr;
+        }
+        use(it->second);
+        return &it->second->second;
+    }
+
+    Value &put(const Key &key, Value value) {
+        auto it = positions.find(key);
+        if (it != positions.end()) {
+            it->second->second = std::move(value);
+            use(it->second);
+            return it->second->second;
+        }
+        entries.emplace_front(key, std::move(value));
+        positions.emplace(key, entries.begin());
+        if (entries.size() > capacity) {
+            positions.erase(entries.back().first);
+            entries.pop_back();
+        }
+        return entries.front().second;
+    }
+
+    void clear() {
+        positions.clear();
+        entries.clear();
+    }
+
+    [[nodiscard]] size_t size() const {
+        return entries.size();
+    }
+};
+
+#endif // UNITTESTBOT_LRUCACHE_H
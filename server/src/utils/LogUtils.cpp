@@ -36,10 +36,14 @@ namespace LogUtils {
         loguru::set_thread_name(LOG_CHANNELS_WATCHER.c_str());
         auto &service = server.testsService;
         while (true) {
-            if (server.logChannelsWatcherCancellationToken) {
-                return true;
+            {
+                std::unique_lock<std::mutex> lock(server.logChannelsWatcherMutex);
+                if (server.logChannelsWatcherCondition.wait_for(
+                        lock, TimeUtils::IDLE_TIMEOUT,
+                        [&server] { return server.logChannelsWatcherCancellationToken.load(); })) {
+                    return true;
+                }
             }
-            std::this_thread::sleep_for(TimeUtils::IDLE_TIMEOUT);
             const std::lock_guard<std::mutex> lock(server.testsService.logChannelOperationsMutex);
             auto now = TimeUtils::now();
             std::vector <std::string> outdatedClients;
@@ -0,0 +1,68 @@
+#include "PathTrie.h"
+
+PathTrie::PathTrie() : nodes(1) {
+}
+
+void PathTrie::insert(const fs::path &path) {
+    fs::path normalized = path.lexically_normal();
+    size_t node = 0;
+    for (const fs::path &component : normalized) {
+        auto it = nodes[node].children.find(component.string());
+        if (it != nodes[node].children.end()) {
+            node = it->second;
+        } else {
+            size_t child = nodes.size();
+            nodes[node].children.emplace(component.string(), child);
+            nodes.emplace_back();
+            node = child;
+        }
+    }
+    if (!nodes[node].path.has_value()) {
+        nodes[node].path = std::move(normalized);
+        ++pathsCount;
+    }
+}
+
+std::optional<size_t> PathTrie::findNode(const fs::path &path) const {
+    size_t node = 0;
+    for (const fs::path &component : path.lexically_normal()) {
+        auto it = nodes[node].children.find(component.string());
+        if (it == nodes[node].children.end()) {
+            return std::nullopt;
+        }
+        node = it->second;
+    }
+    return node;
+}
+
+bool PathTrie::contains(const fs::path &path) const {
+    auto node = findNode(path);
+    return node.has_value() && nodes[node.value()].path.has_value();
+}
+
+CollectionUtils::FileSet PathTrie::getPathsUnder(const fs::path &directory) const {
+    CollectionUtils::FileSet result;
+    auto directoryNode = findNode(directory);
+    if (!directoryNode.has_value()) {
+        return result;
+    }
+    std::vector<size_t> stack;
+    for (const auto &[_, child] : nodes[directoryNode.value()].children) {
+        stack.push_back(child);
+    }
+    while (!stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.path.has_value()) {
+            result.insert(node.path.value());
+        }
+        for (const auto &[_, child] : node.children) {
+            stack.push_back(child);
+        }
+    }
+    return result;
+}
+
+size_t PathTrie::size() const {
+    return pathsCount;
+}
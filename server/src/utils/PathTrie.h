@@ -0,0 +1,54 @@
+#ifndef UNITTESTBOT_PATHTRIE_H
+#define UNITTESTBOT_PATHTRIE_H
+
+#include "CollectionUtils.h"
+#include "utils/path/FileSystemPath.h"
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Set of paths organized by their components, so that paths inside a directory are found
+ * without comparing the directory with every stored path. Paths are normalized lexically.
+ */
+class PathTrie {
+public:
+    PathTrie();
+
+    template <typename Container>
+    explicit PathTrie(const Container &paths) : PathTrie() {
+        for (const fs::path &path : paths) {
+            insert(path);
+        }
+    }
+
+    void insert(const fs::path &path);
+
+    [[nodiscard]] bool contains(const fs::path &path) const;
+
+    /**
+     * Returns inserted paths which are inside the directory at any depth, i.e. those for which
+     * Paths::isSubPathOf(directory, path) holds.
+     */
+    [[nodiscard]] CollectionUtils::FileSet getPathsUnder(const fs::path &directory) const;
+
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Node {
+        // component to node index
+        std::unordered_map<std::string, size_t> children;
+        // inserted path ending in this node
+        std::optional<fs::path> path;
+    };
+
+    // nodes[0] is the root
+    std::vector<Node> nodes;
+    size_t pathsCount = 0;
+
+    [[nodiscard]] std::optional<size_t> findNode(const fs::path &path) const;
+};
+
+#endif // UNITTESTBOT_PATHTRIE_H
@@ -37,6 +37,12 @@ namespace ServerUtils {
         loguru::set_thread_name(id.c_str());
     }
 
+    void setTransferOptions(grpc::ServerContext *context, const testsgen::TransferOptions &options) {
+        if (options.compressresponses()) {
+            context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+        }
+    }
+
     void registerClient(concurrent_set<std::string> &clients, std::string client) {
         if (!client.empty()) {
             if (!clients.in(client)) {
@@ -4,10 +4,17 @@
 #include "ThreadSafeContainers.h"
 
 #include <grpcpp/impl/codegen/server_context.h>
+#include <protobuf/testgen.pb.h>
 
 namespace ServerUtils {
     void setThreadOptions(grpc::ServerContext *context, bool testMode);
 
+    /**
+     * Enables compression of responses if client asked for it.
+     * Must be called before the first response is written.
+     */
+    void setTransferOptions(grpc::ServerContext *context, const testsgen::TransferOptions &options);
+
     void registerClient(concurrent_set<std::string> &clients, std::string client);
 
     void loadClientsData(concurrent_set<std::string> &result);
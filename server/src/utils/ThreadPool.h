@@ -0,0 +1,53 @@
+#ifndef UNITTESTBOT_THREADPOOL_H
+#define UNITTESTBOT_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed number of worker threads executing submitted tasks in submission order.
+ * Destructor waits for all queued tasks to be finished.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadsCount);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    template <typename Function>
+    std::future<std::invoke_result_t<Function>> submit(Function &&function) {
+        using Result = std::invoke_result_t<Function>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return result;
+    }
+
+    [[nodiscard]] size_t size() const;
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::queue<std::function<void()>> tasks;
+    bool stopped = false;
+    std::vector<std::thread> workers;
+
+    void workerLoop();
+};
+
+
+#endif // UNITTESTBOT_THREADPOOL_H
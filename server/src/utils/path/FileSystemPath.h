@@ -323,6 +323,12 @@ namespace fs {
             entries_cache.emplace_back(iter_);
         }
 
+        recursive_directory_iterator(const fs::path &directory,
+                                     std::filesystem::directory_options options)
+            : iter_(directory.path_, options) {
+            entries_cache.emplace_back(iter_);
+        }
+
         recursive_directory_iterator() = default;
 
         bool operator==(const recursive_directory_iterator &other) const {
@@ -91,7 +91,7 @@ namespace visitor {
                                                const tests::AbstractValueView *view,
                                                const std::string &access,
                                                int depth) {
-        auto structInfo = typesHandler->getStructInfo(type);
+        const auto &structInfo = typesHandler->getStructInfo(type);
         auto subViews = view ? &view->getSubViews() : nullptr;
         for (int i = 0; i < structInfo.fields.size(); i++) {
             auto const &field = structInfo.fields[i];
@@ -106,7 +106,7 @@ namespace visitor {
                                               const tests::AbstractValueView *view,
                                               const std::string &access,
                                               int depth) {
-        auto unionInfo = typesHandler->getUnionInfo(type);
+        const auto &unionInfo = typesHandler->getUnionInfo(type);
         auto subViews = view ? &view->getSubViews() : nullptr;
 
         bool oldFlag = inUnion;
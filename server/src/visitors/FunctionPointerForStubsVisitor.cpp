@@ -36,7 +36,7 @@ namespace visitor {
         if (!inserted) {
             return;
         }
-        auto structInfo = typesHandler->getStructInfo(type);
+        const auto &structInfo = typesHandler->getStructInfo(type);
         for (const auto &[name, field] : structInfo.functionFields) {
             auto stubName =
                 PrinterUtils::getFunctionPointerAsStructFieldStubName(structInfo.name, name, true);
@@ -251,6 +251,17 @@ namespace {
         checkResultsDirectory();
     }
 
+    TEST_F(CLI_Test, Coverage_Only_Conflicting_Flags_Test) {
+        for (const std::string &flag : { "--no-coverage", "--sanitize-failed-only" }) {
+            EXPECT_THROW(runCommandLine({ "./utbot", "run", "--project-path", suitePath,
+                                          "--build-dir", buildDirectoryName, "project",
+                                          "--coverage-only", flag }),
+                         CLI::ValidationError)
+                << flag;
+        }
+        EXPECT_FALSE(fs::exists(suitePath / resultsDirectoryName / "execution-stats.csv"));
+    }
+
     TEST_F(CLI_Test, Run_Specific_Test) {
         runCommandLine({ "./utbot", "generate", "--project-path", suitePath,
                          "--build-dir", buildDirectoryName, "file",
@@ -1,19 +1,30 @@
 #include "gtest/gtest.h"
 
 #include "BaseTest.h"
+#include "BordersFinder.h"
 #include "KleeGenerator.h"
 #include "ProjectContext.h"
 #include "Server.h"
 #include "clang-utils/SourceToHeaderRewriter.h"
 #include "coverage/CoverageAndResultsGenerator.h"
 #include "printers/HeaderPrinter.h"
+#include "printers/KleeConstraintsPrinter.h"
 #include "printers/TestMakefilesPrinter.h"
 #include "printers/SourceWrapperPrinter.h"
+#include "utils/CompilationUtils.h"
 #include "utils/FileSystemUtils.h"
+#include "utils/JsonUtils.h"
 #include "utils/ServerUtils.h"
 
 #include "utils/path/FileSystemPath.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
 #include <functional>
+#include <future>
+#include <map>
+#include <thread>
 #include <tuple>
 
 namespace {
@@ -838,6 +849,33 @@ namespace {
         checkLinkage(testGen);
     }
 
+    TEST_F(Server_Test, Skipped_Functions_Commented_In_Test_File) {
+        auto projectRequest =
+            createProjectRequest(projectName, suitePath, buildDirRelativePath, srcPaths);
+        projectRequest->mutable_settingscontext()->set_generateforstaticfunctions(false);
+        auto request = GrpcUtils::createFileRequest(std::move(projectRequest), linkage_c);
+        auto testGen = FileTestGen(*request, writer.get(), TESTMODE);
+        testGen.setTargetForSource(linkage_c);
+        Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
+        ASSERT_TRUE(status.ok()) << status.error_message();
+
+        const auto &tests = testGen.tests.at(linkage_c);
+        EXPECT_FALSE(CollectionUtils::containsKey(tests.methods, "static_sum"));
+        ASSERT_EQ(1, tests.skipRecords.size());
+        const std::string comment = "Function 'static_sum' was skipped, as option "
+                                    "\"Generate For Static Functions\"is disabled";
+        EXPECT_NE(std::string::npos, tests.code.find(comment)) << tests.code;
+
+        fs::path testFilePath = tests.testSourceFilePath;
+        ASSERT_TRUE(fs::exists(testFilePath)) << testFilePath;
+        std::string writtenCode;
+        {
+            std::ifstream stream(testFilePath.string());
+            writtenCode.assign(std::istreambuf_iterator<char>(stream), {});
+        }
+        EXPECT_NE(std::string::npos, writtenCode.find(comment)) << writtenCode;
+    }
+
     TEST_F(Server_Test, Globals) {
         auto [testGen, status] = performFeatureFileTestsRequest(globals_c);
         ASSERT_TRUE(status.ok()) << status.error_message();
@@ -863,6 +901,214 @@ namespace {
         checkAlignment(testGen);
     }
 
+    TEST_F(Server_Test, Single_Pass_Source_Outputs_Test) {
+        for (std::string const &suite : { "server", "syntax" }) {
+            setSuite(suite);
+            // outputs of previous tests would be reused without a pass over the sources
+            SourceToHeaderRewriter::clearCachedSourceOutputs();
+            utbot::ProjectContext projectContext{ projectName, suitePath, getTestDirectory(),
+                                                  buildDirRelativePath };
+            auto compilationDatabase = CompilationUtils::getCompilationDatabase(buildPath);
+            auto structsToDeclare = std::make_shared<Fetcher::FileToStringSet>();
+            for (fs::path const &sourceFile : compilationDatabase->getAllFiles()) {
+                (*structsToDeclare)[sourceFile].insert("utbot_declared_struct");
+            }
+            SourceToHeaderRewriter separateRewriter(projectContext, compilationDatabase,
+                                                    structsToDeclare, buildPath / "temp");
+            SourceToHeaderRewriter sourceToHeaderRewriter(projectContext, compilationDatabase,
+                                                          structsToDeclare, buildPath / "temp");
+            fs::path stubHeaderPath = buildPath / "temp" / "single_pass_stub.h";
+            fs::create_directories(stubHeaderPath.parent_path());
+            size_t filesWithStubs = 0;
+            for (fs::path const &sourceFile : compilationDatabase->getAllFiles()) {
+                tests::Tests tests;
+                tests.sourceFilePath = sourceFile;
+
+                // outputs of separate passes, one for each output, as before the single pass
+                std::string expectedStubDeclarations =
+                    separateRewriter.generateSourceDeclarations(sourceFile, true)
+                        .externalDeclarations;
+                std::string expectedStubHeader = SourceToHeaderRewriter::printStubHeader(
+                    expectedStubDeclarations, stubHeaderPath);
+                // creation time is kept for the unchanged header, so the whole header is compared
+                FileSystemUtils::writeToFile(stubHeaderPath, expectedStubHeader);
+                if (!expectedStubDeclarations.empty()) {
+                    filesWithStubs++;
+                }
+
+                // the pass over the source with declared structs fills every output at once
+                std::string stubHeader =
+                    sourceToHeaderRewriter.generateStubHeader(sourceFile, stubHeaderPath);
+                EXPECT_EQ(expectedStubHeader, stubHeader) << sourceFile;
+                std::string wrapper = sourceToHeaderRewriter.generateWrapper(sourceFile);
+                if (!Paths::isCFile(sourceFile)) {
+                    EXPECT_TRUE(wrapper.empty()) << sourceFile;
+                    continue;
+                }
+
+                auto expectedTestDeclarations =
+                    separateRewriter.generateSourceDeclarations(sourceFile, false);
+                EXPECT_TRUE(StringUtils::contains(expectedTestDeclarations.externalDeclarations,
+                                                  "utbot_declared_struct"))
+                    << sourceFile;
+                EXPECT_EQ(SourceToHeaderRewriter::printTestHeader(expectedTestDeclarations),
+                          sourceToHeaderRewriter.generateTestHeader(sourceFile, tests))
+                    << sourceFile;
+                // the wrapper is compiled with the original source and must not declare structs
+                EXPECT_EQ(separateRewriter.generateSourceWrapper(sourceFile), wrapper)
+                    << sourceFile;
+                EXPECT_FALSE(StringUtils::contains(wrapper, "utbot_declared_struct")) << sourceFile;
+            }
+            fs::remove(stubHeaderPath);
+            EXPECT_GT(filesWithStubs, 0) << suite;
+        }
+    }
+
+    TEST_F(Server_Test, Filtered_Fetch_Matches_Erased_Methods_Test) {
+        auto projectRequest =
+            createProjectRequest(projectName, suitePath, buildDirRelativePath, srcPaths);
+        auto request = GrpcUtils::createFileRequest(std::move(projectRequest), basic_functions_c);
+        FileTestGen testGen(*request, writer.get(), TESTMODE);
+        auto fetch = [&](const Fetcher::FunctionFilter &filter) {
+            tests::TestsMap tests = testGen.tests;
+            types::TypeMaps types;
+            types::TypesHandler::SizeContext sizeContext;
+            Fetcher fetcher(Fetcher::Options::Value::ALL, testGen.compilationDatabase, tests,
+                            &types, &sizeContext.pointerSize, &sizeContext.maximumAlignment,
+                            testGen.compileCommandsJsonPath, false);
+            fetcher.setFunctionFilter(filter);
+            fetcher.fetch();
+            return tests.at(basic_functions_c).methods;
+        };
+
+        auto allMethods = fetch(nullptr);
+        ASSERT_GT(allMethods.size(), 1);
+        for (const std::string &methodName : CollectionUtils::getKeys(allMethods)) {
+            // methods left by erasing the others from the whole file, as line requests did
+            auto erased = allMethods;
+            CollectionUtils::erase_if(erased, [&methodName](const auto &method) {
+                return method.name != methodName;
+            });
+            auto filtered = fetch([&methodName](const fs::path &sourceFilePath,
+                                                const clang::FunctionDecl *decl) {
+                return sourceFilePath != basic_functions_c || decl->getNameAsString() == methodName;
+            });
+            ASSERT_EQ(CollectionUtils::getKeys(erased), CollectionUtils::getKeys(filtered))
+                << methodName;
+            const auto &expected = erased.begin().value();
+            const auto &actual = filtered.begin().value();
+            EXPECT_EQ(expected.paramsString, actual.paramsString) << methodName;
+            EXPECT_EQ(expected.returnType, actual.returnType) << methodName;
+            EXPECT_EQ(expected.getParamNames(), actual.getParamNames()) << methodName;
+            EXPECT_EQ(expected.getParamTypes(), actual.getParamTypes()) << methodName;
+            EXPECT_EQ(expected.globalParams.size(), actual.globalParams.size()) << methodName;
+            EXPECT_EQ(expected.isVariadic, actual.isVariadic) << methodName;
+        }
+    }
+
+    TEST_F(Server_Test, Cached_Constraints_Match_Uncached_Test) {
+        auto projectRequest =
+            createProjectRequest(projectName, suitePath, buildDirRelativePath, srcPaths);
+        auto request = GrpcUtils::createFileRequest(std::move(projectRequest), types_c);
+        FileTestGen testGen(*request, writer.get(), TESTMODE);
+        types::TypesHandler::SizeContext sizeContext;
+        Fetcher fetcher(Fetcher::Options::Value::ALL, testGen.compilationDatabase, testGen.tests,
+                        &testGen.types, &sizeContext.pointerSize, &sizeContext.maximumAlignment,
+                        testGen.compileCommandsJsonPath, false);
+        fetcher.fetch();
+        types::TypesHandler typesHandler{ testGen.types, sizeContext };
+        auto language = Paths::getSourceLanguage(types_c);
+
+        printer::KleeConstraintsPrinter::TemplateCache templateCache;
+        size_t paramsCount = 0;
+        for (const auto &[methodName, method] : testGen.tests.at(types_c).methods) {
+            for (const auto &param : method.params) {
+                // '$' is a valid identifier character, so names with it are substituted too
+                for (const std::string &name : { param.name, "utbot$" + param.name + "$" }) {
+                    printer::KleeConstraintsPrinter uncachedPrinter(&typesHandler, language);
+                    std::string uncached = uncachedPrinter.genConstraints(name, param.type).str();
+                    printer::KleeConstraintsPrinter cachedPrinter(&typesHandler, language,
+                                                                  &templateCache);
+                    std::string cached = cachedPrinter.genConstraints(name, param.type).str();
+                    EXPECT_EQ(uncached, cached) << methodName << " " << name;
+                }
+                ++paramsCount;
+            }
+        }
+        EXPECT_GT(paramsCount, 0);
+        EXPECT_FALSE(templateCache.empty());
+    }
+
+    TEST_F(Server_Test, Stub_Header_Follows_Source_Changes_Test) {
+        utbot::ProjectContext projectContext{ projectName, suitePath, getTestDirectory(),
+                                              buildDirRelativePath };
+        auto compilationDatabase = CompilationUtils::getCompilationDatabase(buildPath);
+        SourceToHeaderRewriter sourceToHeaderRewriter(projectContext, compilationDatabase, nullptr,
+                                                      buildPath / "temp");
+        fs::path stubHeaderPath = buildPath / "no_stub.h";
+        std::string code;
+        {
+            std::ifstream stream(basic_functions_c.string());
+            code.assign(std::istreambuf_iterator<char>(stream), {});
+        }
+        std::string addedFunction = "int utbot_added_function(int x) { return x; }\n";
+
+        auto header = sourceToHeaderRewriter.generateStubHeader(basic_functions_c, stubHeaderPath);
+        EXPECT_TRUE(StringUtils::contains(header, "max_"));
+        // repeated requests do not reuse outputs of the previous version of the source
+        FileSystemUtils::writeToFile(basic_functions_c, code + addedFunction);
+        auto changedHeader =
+            sourceToHeaderRewriter.generateStubHeader(basic_functions_c, stubHeaderPath);
+        FileSystemUtils::writeToFile(basic_functions_c, code);
+        auto restoredHeader =
+            sourceToHeaderRewriter.generateStubHeader(basic_functions_c, stubHeaderPath);
+
+        EXPECT_TRUE(StringUtils::contains(changedHeader, "utbot_added_function"));
+        EXPECT_FALSE(StringUtils::contains(restoredHeader, "utbot_added_function"));
+        EXPECT_TRUE(StringUtils::contains(restoredHeader, "max_"));
+    }
+
+    TEST_F(Server_Test, Borders_Index_Test) {
+        auto compilationDatabase = CompilationUtils::getCompilationDatabase(buildPath);
+        bool indexReused = false;
+        auto findFunction = [&](unsigned line) {
+            BordersFinder finder(basic_functions_c, line, compilationDatabase, buildPath);
+            finder.findFunction();
+            indexReused = finder.isIndexReused();
+            return finder.getLineInfo();
+        };
+        // the first lookup builds the index of the file, the others reuse it
+        for (int pass = 0; pass < 2; ++pass) {
+            auto returnLine = findFunction(5);
+            ASSERT_TRUE(returnLine.initialized);
+            EXPECT_EQ("max_", returnLine.methodName);
+            EXPECT_EQ(5, returnLine.begin);
+            EXPECT_EQ(5, returnLine.end);
+            EXPECT_FALSE(returnLine.insertAfter);
+            EXPECT_TRUE(StringUtils::contains(returnLine.stmtString, "return a")) << returnLine.stmtString;
+
+            EXPECT_EQ("sqr_positive", findFunction(14).methodName);
+            EXPECT_TRUE(indexReused);
+            EXPECT_EQ("simple_loop", findFunction(22).methodName);
+            EXPECT_FALSE(findFunction(10).initialized);
+        }
+
+        std::string code;
+        {
+            std::ifstream stream(basic_functions_c.string());
+            code.assign(std::istreambuf_iterator<char>(stream), {});
+        }
+        // touched file is read again, but the index is reused while the content is the same
+        fs::last_write_time(basic_functions_c, fs::file_time_type::clock::now());
+        EXPECT_EQ("max_", findFunction(5).methodName);
+        EXPECT_TRUE(indexReused);
+
+        FileSystemUtils::writeToFile(basic_functions_c, code + "// modified\n");
+        EXPECT_EQ("max_", findFunction(5).methodName);
+        EXPECT_FALSE(indexReused);
+        FileSystemUtils::writeToFile(basic_functions_c, code);
+    }
+
     class Parameterized_Server_Test : public Server_Test,
                                       public testing::WithParamInterface<std::tuple<CompilerName>> {
     protected:
@@ -905,6 +1151,30 @@ namespace {
         EXPECT_FALSE(fs::exists(stubPath)) << "Stub must not be generated: " << stubPath;
     }
 
+    TEST_P(Parameterized_Server_Test, Snippet_Link_Without_Makefiles_Test) {
+        auto request = createSnippetRequest(projectName, suitePath, snippet_c);
+        auto testGen = SnippetTestGen(*request, writer.get(), TESTMODE);
+        std::vector<fs::path> makefiles = {
+            testGen.serverBuildDir / "GenerationCompileMakefile.mk",
+            testGen.serverBuildDir / "GenerationStubsMakefile.mk",
+            testGen.serverBuildDir / "GenerationLinkMakefile.mk",
+            Paths::getMakefilePathFromSourceFilePath(testGen.projectContext, snippet_c)
+        };
+        for (const auto &makefile : makefiles) {
+            fs::remove(makefile);
+        }
+
+        Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
+        ASSERT_TRUE(status.ok()) << status.error_message();
+
+        auto testFilePaths = CollectionUtils::getKeys(testGen.tests);
+        ASSERT_EQ(1, testFilePaths.size());
+        EXPECT_EQ(1, testGen.tests.at(testFilePaths[0]).methods.begin().value().testCases.size());
+        for (const auto &makefile : makefiles) {
+            EXPECT_FALSE(fs::exists(makefile)) << "Snippet must be linked without makefiles: " << makefile;
+        }
+    }
+
     TEST_P(Parameterized_Server_Test, Project_Test) {
         std::string suite = "small-project";
         setSuite(suite);
@@ -992,6 +1262,10 @@ namespace {
             createProjectRequest(projectName, suitePath, buildDirRelativePath, srcPaths);
         auto request = GrpcUtils::createFolderRequest(std::move(projectRequest), suitePath / "inner");
         auto testGen = FolderTestGen(*request, writer.get(), TESTMODE);
+        for (const auto &[sourcePath, _] : testGen.tests) {
+            EXPECT_TRUE(Paths::isSubPathOf(suitePath / "inner", sourcePath)) << sourcePath;
+            EXPECT_TRUE(CollectionUtils::contains(testGen.sourcePaths, sourcePath)) << sourcePath;
+        }
         setTargetForFirstSource(testGen);
         Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
         ASSERT_TRUE(status.ok()) << status.error_message();
@@ -1274,6 +1548,55 @@ namespace {
         EXPECT_GE(coverageGenerator.getTotals()["lines"]["percent"], 90);
     }
 
+    // file of the shared suite changed by a test gets its content and time back on any exit
+    class RestoredFile {
+    public:
+        explicit RestoredFile(fs::path filePath)
+            : path(std::move(filePath)), modificationTime(fs::last_write_time(path)) {
+            std::ifstream stream(path.string());
+            content.assign(std::istreambuf_iterator<char>(stream), {});
+        }
+
+        ~RestoredFile() {
+            try {
+                FileSystemUtils::writeToFile(path, content);
+                fs::last_write_time(path, modificationTime);
+            } catch (const std::exception &e) {
+                ADD_FAILURE() << "Couldn't restore " << path << ": " << e.what();
+            }
+        }
+
+        const fs::path path;
+        std::string content;
+
+    private:
+        fs::file_time_type modificationTime;
+    };
+
+    TEST_P(TestRunner_Test, Tests_From_Manifest_Test) {
+        fs::path manifestPath = Paths::getTestManifestPath(*projectContext, dependent_functions_c);
+        ASSERT_TRUE(fs::exists(manifestPath));
+
+        auto toNames = [](const std::vector<UnitTest> &tests) {
+            return CollectionUtils::transform(tests, [](const UnitTest &test) {
+                return test.suitename + "." + test.testname;
+            });
+        };
+        TestRunner manifestRunner(*projectContext, dependent_functions_test_cpp, "", "",
+                                  writer.get());
+        auto manifestTests = manifestRunner.getTestsToLaunch();
+        EXPECT_FALSE(manifestTests.empty());
+
+        // modified test file is listed by gtest
+        RestoredFile testFile(dependent_functions_test_cpp);
+        FileSystemUtils::writeToFile(testFile.path, testFile.content + "// modified\n");
+        TestRunner gtestRunner(*projectContext, dependent_functions_test_cpp, "", "",
+                               writer.get());
+        auto gtestTests = gtestRunner.getTestsToLaunch();
+
+        EXPECT_EQ(toNames(gtestTests), toNames(manifestTests));
+    }
+
     TEST_P(TestRunner_Test, Coverage_File_Test) {
         CoverageLines linesCovered;
         CoverageLines linesUncovered;
@@ -1341,6 +1664,294 @@ namespace {
     }
 
 
+    TEST_F(Server_Test, Heartbeat_Under_Load_Test) {
+        // every worker gets a generation
+        const size_t generationsCount = 3;
+        setenv("UTBOT_SERVER_WORKERS", std::to_string(generationsCount).c_str(), 1);
+        // the first generation is held with the client lock, the others wait for it on workers
+        std::promise<void> generationHeld;
+        std::promise<void> generationReleased;
+        std::shared_future<void> released = generationReleased.get_future().share();
+        std::atomic_bool held = false;
+        server.testsService.generationStartedHook = [&generationHeld, &held, released]() {
+            if (!held.exchange(true)) {
+                generationHeld.set_value();
+            }
+            released.wait();
+        };
+
+        const uint16_t port = testUtils::getFreePort();
+        ASSERT_NE(port, 0);
+        std::thread serverThread([this, port]() { server.run(port); });
+        auto channel = grpc::CreateChannel("localhost:" + std::to_string(port),
+                                           grpc::InsecureChannelCredentials());
+        EXPECT_TRUE(channel->WaitForConnected(std::chrono::system_clock::now() +
+                                              std::chrono::seconds(10)));
+        // the workers are created once the server listens
+        unsetenv("UTBOT_SERVER_WORKERS");
+        auto stub = TestsGenService::NewStub(channel);
+        auto withDeadline = [](ClientContext &context) {
+            context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(30));
+        };
+
+        // the log channel receives logs of the handlers below, so its writes must not
+        // wait for the threads that run these handlers
+        const std::string clientId = "heartbeat_test_client";
+        ClientContext logContext;
+        logContext.AddMetadata("clientid", clientId);
+        testsgen::LogChannelRequest logRequest;
+        logRequest.set_loglevel("INFO");
+        auto logReader = stub->OpenLogChannel(&logContext, logRequest);
+
+        {
+            ClientContext context;
+            withDeadline(context);
+            testsgen::RegisterClientRequest request;
+            request.set_clientid(clientId);
+            testsgen::DummyResponse response;
+            Status status = stub->RegisterClient(&context, request, &response);
+            EXPECT_TRUE(status.ok()) << status.error_message();
+        }
+
+        std::vector<std::unique_ptr<ClientContext>> generationContexts;
+        std::vector<std::thread> generations;
+        std::atomic_size_t startedGenerations = 0;
+        for (size_t i = 0; i < generationsCount; ++i) {
+            generationContexts.push_back(std::make_unique<ClientContext>());
+            generations.emplace_back([&stub, &startedGenerations,
+                                      context = generationContexts.back().get(), this]() {
+                auto request = createProjectRequest(projectName, suitePath, buildDirRelativePath,
+                                                    srcPaths);
+                request->set_targetpath(GrpcUtils::UTBOT_AUTO_TARGET_PATH);
+                auto reader = stub->GenerateProjectTests(context, *request);
+                TestsResponse response;
+                bool started = false;
+                while (reader->Read(&response)) {
+                    if (!started) {
+                        started = true;
+                        ++startedGenerations;
+                    }
+                }
+                if (!started) {
+                    // generation ended without progress, so nothing is waited for
+                    ++startedGenerations;
+                }
+                reader->Finish();
+            });
+        }
+        // the waiting generations report it, so each of them occupies a worker
+        generationHeld.get_future().wait();
+        while (startedGenerations < generationsCount - 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        // all workers are busy now, short calls still have to be answered promptly
+        const auto MAX_HEARTBEAT_LATENCY = std::chrono::seconds(2);
+        auto maxLatency = std::chrono::steady_clock::duration::zero();
+        for (size_t i = 0; i < 20; ++i) {
+            ClientContext context;
+            withDeadline(context);
+            context.AddMetadata("clientid", clientId);
+            testsgen::DummyRequest request;
+            testsgen::HeartbeatResponse response;
+            auto start = std::chrono::steady_clock::now();
+            Status status = stub->Heartbeat(&context, request, &response);
+            maxLatency = std::max(maxLatency, std::chrono::steady_clock::now() - start);
+            EXPECT_TRUE(status.ok()) << status.error_message();
+        }
+        EXPECT_LT(maxLatency, MAX_HEARTBEAT_LATENCY);
+        {
+            ClientContext context;
+            withDeadline(context);
+            testsgen::VersionInfo request;
+            testsgen::VersionInfo response;
+            auto start = std::chrono::steady_clock::now();
+            Status status = stub->Handshake(&context, request, &response);
+            EXPECT_LT(std::chrono::steady_clock::now() - start, MAX_HEARTBEAT_LATENCY);
+            EXPECT_TRUE(status.ok()) << status.error_message();
+        }
+
+        for (auto &context : generationContexts) {
+            context->TryCancel();
+        }
+        generationReleased.set_value();
+        for (auto &generation : generations) {
+            generation.join();
+        }
+        server.testsService.generationStartedHook = nullptr;
+
+        {
+            ClientContext context;
+            withDeadline(context);
+            context.AddMetadata("clientid", clientId);
+            testsgen::DummyRequest request;
+            testsgen::DummyResponse response;
+            Status status = stub->CloseLogChannel(&context, request, &response);
+            EXPECT_TRUE(status.ok()) << status.error_message();
+        }
+        bool handshakeLogged = false;
+        testsgen::LogEntry entry;
+        while (logReader->Read(&entry)) {
+            handshakeLogged |= StringUtils::contains(entry.message(), "Handshake complete");
+        }
+        EXPECT_TRUE(logReader->Finish().ok());
+        EXPECT_TRUE(handshakeLogged);
+
+        server.shutdown();
+        serverThread.join();
+    }
+
+    /**
+     * Copies sources and build commands of a suite, so that a test may rewrite them.
+     * The copy is removed when the guard is destroyed.
+     */
+    class SuiteCopy {
+    public:
+        SuiteCopy(const fs::path &suitePath, const std::string &buildDirRelativePath)
+            : path(fs::path(std::filesystem::temp_directory_path()) / "utbot_suite_copy" /
+                   suitePath.filename()) {
+            fs::remove_all(path);
+            fs::create_directories(path / buildDirRelativePath);
+            for (const auto &entry : std::filesystem::directory_iterator(suitePath.string())) {
+                std::string name = entry.path().filename().string();
+                if (name == buildDirRelativePath || name == "tests") {
+                    continue;
+                }
+                std::filesystem::copy(entry.path(), (path / name).string(),
+                                      std::filesystem::copy_options::recursive);
+            }
+            for (const std::string &fileName : { "compile_commands.json", "link_commands.json" }) {
+                fs::copy(suitePath / buildDirRelativePath / fileName,
+                         path / buildDirRelativePath / fileName);
+            }
+        }
+
+        ~SuiteCopy() {
+            std::error_code ec;
+            std::filesystem::remove_all(path.string(), ec);
+        }
+
+        const fs::path path;
+    };
+
+    TEST_F(Server_Test, Read_Only_Requests_During_Generation_Test) {
+        SuiteCopy suite(suitePath, buildDirRelativePath);
+        const fs::path copiedBasicFunctionsC = suite.path / basic_functions_c.filename();
+
+        // generation is held right after it takes the client lock, until the reads are done
+        std::promise<void> generationHeld;
+        std::promise<void> generationReleased;
+        std::shared_future<void> released = generationReleased.get_future().share();
+        server.testsService.generationStartedHook = [&generationHeld, released]() {
+            generationHeld.set_value();
+            released.wait();
+        };
+
+        const uint16_t port = testUtils::getFreePort();
+        ASSERT_NE(port, 0);
+        std::thread serverThread([this, port]() { server.run(port); });
+        auto channel = grpc::CreateChannel("localhost:" + std::to_string(port),
+                                           grpc::InsecureChannelCredentials());
+        EXPECT_TRUE(channel->WaitForConnected(std::chrono::system_clock::now() +
+                                              std::chrono::seconds(10)));
+        auto stub = TestsGenService::NewStub(channel);
+
+        // a read that waited for the held generation would hit the deadline instead
+        const auto MAX_READ_LATENCY = std::chrono::seconds(10);
+        auto timedCall = [&](const std::string &name, const std::function<Status(ClientContext &)> &call) {
+            ClientContext context;
+            context.set_deadline(std::chrono::system_clock::now() + 3 * MAX_READ_LATENCY);
+            auto start = std::chrono::steady_clock::now();
+            Status status = call(context);
+            auto latency = std::chrono::steady_clock::now() - start;
+            EXPECT_TRUE(status.ok()) << name << ": " << status.error_message();
+            EXPECT_LT(latency, MAX_READ_LATENCY) << name << " waited for the generation";
+        };
+        auto readProjectModel = [&]() {
+            auto projectContext = GrpcUtils::createProjectContext(
+                projectName, suite.path, suite.path / "tests", buildDirRelativePath);
+            timedCall("GetProjectTargets", [&](ClientContext &context) {
+                testsgen::ProjectTargetsRequest request;
+                request.set_allocated_projectcontext(
+                    std::make_unique<testsgen::ProjectContext>(*projectContext).release());
+                testsgen::ProjectTargetsResponse response;
+                Status status = stub->GetProjectTargets(&context, request, &response);
+                EXPECT_FALSE(response.targets().empty());
+                return status;
+            });
+            timedCall("GetFileTargets", [&](ClientContext &context) {
+                testsgen::FileTargetsRequest request;
+                request.set_path(copiedBasicFunctionsC.string());
+                request.set_allocated_projectcontext(
+                    std::make_unique<testsgen::ProjectContext>(*projectContext).release());
+                testsgen::FileTargetsResponse response;
+                return stub->GetFileTargets(&context, request, &response);
+            });
+            timedCall("GetSourceCode", [&](ClientContext &context) {
+                auto request = GrpcUtils::createSourceInfo(copiedBasicFunctionsC, 0);
+                testsgen::SourceCode response;
+                Status status = stub->GetSourceCode(&context, *request, &response);
+                EXPECT_FALSE(response.code().empty());
+                return status;
+            });
+            timedCall("GetFunctionReturnType", [&](ClientContext &context) {
+                auto request = GrpcUtils::createFunctionRequest(testUtils::createLineRequest(
+                    projectName, suite.path, buildDirRelativePath, srcPaths,
+                    copiedBasicFunctionsC, 5, false, false, 30));
+                testsgen::FunctionTypeResponse response;
+                Status status = stub->GetFunctionReturnType(&context, *request, &response);
+                EXPECT_EQ(testsgen::INT32_T, response.validationtype());
+                return status;
+            });
+        };
+        // the first requests build the project snapshot
+        readProjectModel();
+
+        ClientContext generationContext;
+        std::thread generation([&, this]() {
+            auto request = createProjectRequest(projectName, suite.path, buildDirRelativePath,
+                                                srcPaths);
+            request->set_targetpath(GrpcUtils::UTBOT_AUTO_TARGET_PATH);
+            auto reader = stub->GenerateProjectTests(&generationContext, *request);
+            TestsResponse response;
+            while (reader->Read(&response)) {
+            }
+            reader->Finish();
+        });
+        generationHeld.get_future().wait();
+
+        // commands are rewritten as a configuration does, reads must never see a partial file
+        fs::path compileCommandsJsonPath =
+            CompilationUtils::substituteRemotePathToCompileCommandsJsonPath(suite.path,
+                                                                            buildDirRelativePath);
+        std::vector<nlohmann::json> commands;
+        for (const std::string &fileName : { "compile_commands.json", "link_commands.json" }) {
+            commands.push_back(JsonUtils::getJsonFromFile(compileCommandsJsonPath / fileName));
+        }
+        std::atomic_bool readsFinished = false;
+        std::thread configuration([&]() {
+            while (!readsFinished) {
+                JsonUtils::writeJsonToFile(compileCommandsJsonPath / "compile_commands.json",
+                                           commands[0]);
+                JsonUtils::writeJsonToFile(compileCommandsJsonPath / "link_commands.json",
+                                           commands[1]);
+            }
+        });
+        // the generation holds the client lock during all of these reads
+        for (size_t i = 0; i < 10; ++i) {
+            readProjectModel();
+        }
+        readsFinished = true;
+        configuration.join();
+
+        generationContext.TryCancel();
+        generationReleased.set_value();
+        generation.join();
+        server.testsService.generationStartedHook = nullptr;
+        server.shutdown();
+        serverThread.join();
+    }
+
     TEST_F(Server_Test, Halt_Test) {
         std::string suite = "halt";
         setSuite(suite);
@@ -1567,6 +2178,44 @@ namespace {
         }
     }
 
+    TEST_P(Parameterized_Status_Server_Test, Coverage_Only_Test) {
+        if (timeout) {
+            return;
+        }
+        generateMakefilesForProject(pregeneratedTestsRelativeDir);
+        utbot::SettingsContext settingsContext{ true, true, 15, timeout, true, false };
+        auto coveredLines = [](const Coverage::CoverageMap &coverageMap) {
+            std::map<std::string, std::vector<uint32_t>> result;
+            for (const auto &[filePath, fileCoverage] : coverageMap) {
+                for (const auto &sourceLine : fileCoverage.fullCoverageLines) {
+                    result[filePath].push_back(sourceLine.line);
+                }
+            }
+            return result;
+        };
+
+        auto request = createCoverageAndResultsRequest(
+            projectName, suitePath, testsDirPath, buildDirRelativePath,
+            GrpcUtils::createTestFilterForProject());
+        auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
+        CoverageAndResultsGenerator coverageGenerator{ request.get(), coverageAndResultsWriter.get() };
+        coverageGenerator.generate(true, settingsContext);
+        ASSERT_FALSE(coverageGenerator.getCoverageMap().empty());
+
+        auto coverageOnlyRequest = createCoverageAndResultsRequest(
+            projectName, suitePath, testsDirPath, buildDirRelativePath,
+            GrpcUtils::createTestFilterForProject());
+        coverageOnlyRequest->set_coverageonly(true);
+        CoverageAndResultsGenerator coverageOnlyGenerator{ coverageOnlyRequest.get(),
+                                                           coverageAndResultsWriter.get() };
+        coverageOnlyGenerator.generate(true, settingsContext);
+
+        EXPECT_FALSE(coverageOnlyGenerator.hasExceptions());
+        EXPECT_TRUE(coverageOnlyGenerator.getTestResultMap().empty());
+        EXPECT_EQ(coveredLines(coverageGenerator.getCoverageMap()),
+                  coveredLines(coverageOnlyGenerator.getCoverageMap()));
+    }
+
     TEST_P(Parameterized_Server_Test, Clang_Resources_Directory_Test) {
         std::string suite = "stddef";
         setSuite(suite);
@@ -8,8 +8,10 @@
 #include "coverage/CoverageAndResultsGenerator.h"
 #include "streams/coverage/ServerCoverageAndResultsWriter.h"
 #include "streams/stubs/ServerStubsWriter.h"
+#include "utils/HashUtils.h"
 
 #include <fstream>
+#include <map>
 
 namespace {
     using testUtils::createFileRequest;
@@ -100,6 +102,49 @@ namespace {
             return modifiedFileContent;
         }
 
+        /**
+         * Collects stubs sent to client, concatenating chunks of every file.
+         */
+        class StubsResponseCollector : public grpc::ServerWriterInterface<testsgen::StubsResponse> {
+        public:
+            std::map<std::string, std::string> code;
+            std::map<std::string, std::string> hashes;
+            size_t maxSourcesInResponse = 0;
+
+            void SendInitialMetadata() override {
+            }
+
+            bool Write(const testsgen::StubsResponse &response, grpc::WriteOptions) override {
+                maxSourcesInResponse =
+                    std::max(maxSourcesInResponse, static_cast<size_t>(response.stubsources_size()));
+                for (const auto &stub : response.stubsources()) {
+                    std::string &fileCode = code[stub.filepath()];
+                    EXPECT_EQ(fileCode.size(), stub.codeoffset());
+                    fileCode += stub.code();
+                    if (!stub.contenthash().empty()) {
+                        hashes[stub.filepath()] = stub.contenthash();
+                    }
+                }
+                return true;
+            }
+        };
+
+        std::map<std::string, std::string> generateProjectStubs(const testsgen::TransferOptions &options,
+                                                                StubsResponseCollector &collector) {
+            auto stubsWriter = std::make_unique<ServerStubsWriter>(&collector, true, options);
+            auto request = createProjectRequest(projectName, suitePath, buildDirRelativePath, srcPaths, true);
+            auto testGen = std::make_unique<ProjectTestGen>(*request, writer.get(), TESTMODE);
+            Status status =
+                Server::TestsGenServiceImpl::ProcessProjectStubsRequest(testGen.get(), stubsWriter.get());
+            EXPECT_TRUE(status.ok()) << status.error_message();
+            std::map<std::string, std::string> filesOnServer;
+            for (const auto &[path, code] : collector.code) {
+                std::ifstream stream(path);
+                filesOnServer[path] = std::string(std::istreambuf_iterator<char>(stream), {});
+            }
+            return filesOnServer;
+        }
+
         void modifySources(std::vector<fs::path>& sourceFiles) {
             for (const auto& srcPath: sourceFiles) {
                 fs::path modifiedContentPath = suitePath / "modified" / srcPath.filename();
@@ -120,6 +165,32 @@ namespace {
         checkStubFilesExistence(testGen->projectContext, stubSources);
     }
 
+    TEST_F(Stub_Test, Project_Stubs_Transfer_Modes_Test) {
+        StubsResponseCollector fullTransfer;
+        auto filesOnServer = generateProjectStubs({}, fullTransfer);
+        ASSERT_FALSE(filesOnServer.empty());
+        EXPECT_EQ(filesOnServer, fullTransfer.code);
+        // stubs are streamed one by one instead of being packed into one response
+        EXPECT_EQ(1, fullTransfer.maxSourcesInResponse);
+
+        testsgen::TransferOptions chunkedOptions;
+        chunkedOptions.set_maxchunksize(64);
+        StubsResponseCollector chunkedTransfer;
+        filesOnServer = generateProjectStubs(chunkedOptions, chunkedTransfer);
+        EXPECT_EQ(filesOnServer, chunkedTransfer.code);
+
+        testsgen::TransferOptions manifestOptions;
+        manifestOptions.set_sharedfilesystem(true);
+        StubsResponseCollector manifestTransfer;
+        filesOnServer = generateProjectStubs(manifestOptions, manifestTransfer);
+        EXPECT_EQ(fullTransfer.code.size(), manifestTransfer.hashes.size());
+        for (const auto &[path, code] : filesOnServer) {
+            EXPECT_EQ(1, fullTransfer.code.count(path)) << path;
+            EXPECT_TRUE(manifestTransfer.code[path].empty()) << path;
+            EXPECT_EQ(HashUtils::contentHash(code), manifestTransfer.hashes[path]) << path;
+        }
+    }
+
     TEST_F(Stub_Test, Implicit_Stubs_Test) {
         auto request = createFileRequest(projectName, suitePath, buildDirRelativePath, srcPaths,
                                          literals_foo_c, true);
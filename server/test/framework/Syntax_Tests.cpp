@@ -8,6 +8,7 @@
 #include "coverage/CoverageAndResultsGenerator.h"
 
 #include "utils/path/FileSystemPath.h"
+#include <fstream>
 #include <functional>
 
 namespace {
@@ -2226,6 +2227,73 @@ namespace {
         testUtils::checkStatusesCount(resultMap, tests, expectedStatusCountMap);
     }
 
+    TEST_F(Syntax_Test, Sanitizers_Are_Switched_By_Make_Variable) {
+        auto request = testUtils::createFileRequest(projectName, suitePath, buildDirRelativePath,
+                                                    srcPaths, tree_c, true, false);
+        auto testGen = FileTestGen(*request, writer.get(), TESTMODE);
+        testGen.setTargetForSource(tree_c);
+        Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
+        ASSERT_TRUE(status.ok()) << status.error_message();
+
+        utbot::ProjectContext projectContext(projectName, suitePath, getTestFilePath("tests"),
+                                             buildDirRelativePath);
+        fs::path makefile = Paths::getMakefilePathFromSourceFilePath(projectContext, tree_c);
+        fs::path testExecutable = Paths::removeExtension(
+            Paths::removeExtension(Paths::getRecompiledFile(projectContext, tree_c)));
+        auto isSanitized = [&testExecutable]() {
+            std::ifstream binary(testExecutable.string(), std::ios::binary);
+            std::string content(std::istreambuf_iterator<char>(binary), {});
+            return content.find("asan") != std::string::npos;
+        };
+
+        auto plainBuild = MakefileUtils::MakefileCommand(projectContext, makefile, "build", "",
+                                                         { "UTBOT_SANITIZE=0" });
+        ASSERT_EQ(0, plainBuild.run(projectContext.buildDir()).status);
+        EXPECT_FALSE(isSanitized());
+
+        auto sanitizedBuild = MakefileUtils::MakefileCommand(projectContext, makefile, "build");
+        ASSERT_EQ(0, sanitizedBuild.run(projectContext.buildDir()).status);
+        EXPECT_TRUE(isSanitized());
+
+        auto bin = MakefileUtils::MakefileCommand(projectContext, makefile, "bin");
+        EXPECT_EQ(0, bin.run(projectContext.buildDir()).status);
+    }
+
+    TEST_F(Syntax_Test, Run_Tests_For_Tree_Sanitize_Failed_Only) {
+        auto request = testUtils::createFileRequest(projectName, suitePath, buildDirRelativePath,
+                                                    srcPaths, tree_c, true, false);
+        auto testGen = FileTestGen(*request, writer.get(), TESTMODE);
+        testGen.setTargetForSource(tree_c);
+        Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
+        ASSERT_TRUE(status.ok()) << status.error_message();
+
+        fs::path testsDirPath = getTestFilePath("tests");
+
+        fs::path tree_test_cpp = Paths::sourcePathToTestPath(utbot::ProjectContext(
+            projectName, suitePath, testsDirPath, buildDirRelativePath), tree_c);
+        auto testFilter = GrpcUtils::createTestFilterForFile(tree_test_cpp);
+        auto runRequest = testUtils::createCoverageAndResultsRequest(
+            projectName, suitePath, testsDirPath, buildDirRelativePath, std::move(testFilter));
+        runRequest->set_sanitizefailedtestsonly(true);
+
+        static auto coverageAndResultsWriter =
+            std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
+        CoverageAndResultsGenerator coverageGenerator{ runRequest.get(), coverageAndResultsWriter.get() };
+        utbot::SettingsContext settingsContext{ true, false, 15, 0, false, false };
+        coverageGenerator.generate(false, settingsContext);
+
+        EXPECT_FALSE(coverageGenerator.hasExceptions());
+
+        auto resultMap = coverageGenerator.getTestResultMap();
+        auto tests = coverageGenerator.getTestsToLaunch();
+
+        // statuses of the sanitized rerun are the same as of the fully sanitized run
+        StatusCountMap expectedStatusCountMap{
+            {testsgen::TEST_DEATH, 4},
+            {testsgen::TEST_PASSED, 6}};
+        testUtils::checkStatusesCount(resultMap, tests, expectedStatusCountMap);
+    }
+
     TEST_F(Syntax_Test, Simple_parameter_cpp) {
         auto [testGen, status] = createTestForFunction(different_parameters_cpp, 4);
 
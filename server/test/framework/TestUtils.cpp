@@ -7,6 +7,11 @@
 #include "utils/CollectionUtils.h"
 #include "utils/StringUtils.h"
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 namespace testUtils {
     static std::string getMessageForTestCaseNotMatching(
         size_t predicateNumber,
@@ -397,4 +402,23 @@ namespace testUtils {
                                            "Total Lines Number", "Covered Lines Number", "Line Coverage Ratio (%)"};
         checkStatsCSV(statsPath, header, containedFiles);
     }
+
+    uint16_t getFreePort() {
+        int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (sock == -1) {
+            return 0;
+        }
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t length = sizeof(address);
+        uint16_t port = 0;
+        if (bind(sock, (sockaddr *) &address, sizeof(address)) == 0 &&
+            getsockname(sock, (sockaddr *) &address, &length) == 0) {
+            port = ntohs(address.sin_port);
+        }
+        close(sock);
+        return port;
+    }
 }
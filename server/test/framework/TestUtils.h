@@ -122,6 +122,11 @@ namespace testUtils {
     void checkGenerationStatsCSV(const fs::path &statsPath, const std::vector<fs::path> &containedFiles);
 
     void checkExecutionStatsCSV(const fs::path &statsPath, const std::vector<fs::path> &containedFiles);
+
+    /**
+     * Asks the system for a port that is not in use, so servers started by tests don't clash.
+     */
+    uint16_t getFreePort();
 }
 
 #endif // UNITTESTBOT_TESTUTILS_H
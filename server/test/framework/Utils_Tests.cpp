@@ -1,12 +1,32 @@
 #include "gtest/gtest.h"
 
+#include "NameDecorator.h"
+#include "SARIFGenerator.h"
+#include "Tests.h"
 #include "TestUtils.h"
+#include "building/CompileCommand.h"
+#include "building/LinkCommand.h"
+#include "building/UserProjectConfiguration.h"
+#include "streams/DummyStreamWriter.h"
+#include "streams/WriterUtils.h"
+#include "types/Types.h"
 #include "utils/CollectionUtils.h"
 #include "utils/CompilationUtils.h"
 #include "utils/ExecUtils.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/HashUtils.h"
+#include "utils/JsonUtils.h"
+#include "utils/LRUCache.h"
+#include "utils/PathTrie.h"
 #include "utils/StringUtils.h"
 
 #include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <regex>
+#include <set>
+#include <sstream>
 
 namespace {
     auto projectPath = fs::current_path().parent_path() / testUtils::getRelativeTestSuitePath("server");
@@ -71,6 +91,12 @@ namespace {
                       projectPath / "basic_functions.c",
                       projectPath / "types.c"}),
                   filteredPaths);
+
+        // directories and paths which are not normalized are matched too
+        std::vector<fs::path> unnormalizedDirNames{ projectPath / "zzz" / ".." };
+        CollectionUtils::FileSet unnormalizedPaths{ projectPath / "." / "basic_functions.c" };
+        EXPECT_EQ(1, Paths::filterPathsByDirNames(unnormalizedPaths, unnormalizedDirNames,
+                                                  Paths::isCFile).size());
     }
 
     TEST(Utils_Test, Exec) {
@@ -88,6 +114,32 @@ namespace {
         EXPECT_LE(diff.count(), 10.);
     }
 
+    TEST(Utils_Test, ParallelWorkInheritsRequestState) {
+        auto previousState = RequestEnvironment::getThreadState();
+        std::atomic_bool cancelled = false;
+        RequestEnvironment::setClientId("parallel_client");
+        RequestEnvironment::setCancellationFlag(&cancelled);
+
+        std::vector<int> items(8);
+        std::mutex clientIdsMutex;
+        std::set<std::string> clientIds;
+        ExecUtils::doWorkWithProgressInParallel(
+            items, DummyStreamWriter::getInstance(), "", 4, [&](int) {
+                std::lock_guard<std::mutex> lock(clientIdsMutex);
+                clientIds.insert(RequestEnvironment::getClientId());
+            });
+        EXPECT_EQ(std::set<std::string>{ "parallel_client" }, clientIds);
+
+        cancelled = true;
+        std::atomic_int started = 0;
+        EXPECT_THROW(ExecUtils::doWorkWithProgressInParallel(
+                         items, DummyStreamWriter::getInstance(), "", 4, [&](int) { ++started; }),
+                     CancellationException);
+        EXPECT_EQ(0, started);
+
+        RequestEnvironment::setThreadState(previousState);
+    }
+
     TEST(Utils_Test, AddExt) {
         fs::path filePath = projectPath / "basic_functions.c";
         EXPECT_EQ(projectPath / "basic_functions.bc", Paths::replaceExtension(filePath, ".bc"));
@@ -100,6 +152,28 @@ namespace {
         EXPECT_EQ("CLANG_executable", format);
     }
 
+    TEST(Utils_Test, SkipRecordsRenderSameComments) {
+        using Reason = tests::Tests::SkipRecord::Reason;
+        std::vector<tests::Tests::SkipRecord> records = {
+            { Reason::UNSUPPORTED_RETURN_TYPE, "f", "union U", "Unions are not supported" },
+            { Reason::UNSUPPORTED_PARAMETER, "g", "x", "Parameter has incomplete type" },
+            { Reason::STATIC_FUNCTION, "h" },
+            { Reason::INLINE_FUNCTION, "i" }
+        };
+        std::vector<std::string> expected = {
+            "Function 'f' was skipped, as return type 'union U' is not fully supported: "
+            "Unions are not supported",
+            "Function 'g' was skipped, as parameter 'x' is not fully supported: "
+            "Parameter has incomplete type",
+            "Function 'h' was skipped, as option \"Generate For Static Functions\"is disabled",
+            "Function 'i' was skipped, as inline function without static or extern modifier "
+            "is not supported by now"
+        };
+        for (size_t i = 0; i < records.size(); i++) {
+            EXPECT_EQ(expected[i], records[i].toCommentBlock());
+        }
+    }
+
     TEST(Utils_Test, LongestCommonPath) {
         fs::path a = "/home/utbot/tmp/JollyFish/git-2.29/t/helper";
         fs::path b = "/home/utbot/tmp/JollyFish/git-2.29/libgit.bc";
@@ -133,4 +207,371 @@ namespace {
     TEST(Utils_Test, AddExtension) {
         EXPECT_EQ(Paths::addExtension("/a/b", ".cpp"), "/a/b.cpp");
     }
+
+    TEST(Utils_Test, TypeTableInternsEqualTypes) {
+        auto intPointer = types::Type::createSimpleTypeFromName("int", 1);
+        EXPECT_EQ(intPointer.getHandle(), types::Type::createSimpleTypeFromName("int", 1).getHandle());
+        EXPECT_NE(intPointer.getHandle(), types::Type::intType().getHandle());
+        EXPECT_EQ(intPointer.baseTypeObj(), types::Type::intType());
+
+        auto replaced = intPointer;
+        replaced.replaceUsedType("int_ptr");
+        EXPECT_NE(replaced, intPointer);
+        EXPECT_EQ(replaced.getNameHandle(), intPointer.getNameHandle());
+        EXPECT_EQ("int_ptr", replaced.usedType());
+        EXPECT_EQ("int *", intPointer.usedType());
+    }
+
+    TEST(Utils_Test, TypeTableRemovesUnusedTypes) {
+        const types::TypeTable &typeTable = types::TypeTable::getInstance();
+        size_t sizeBefore = typeTable.size();
+        types::TypeHandle handle;
+        {
+            auto type = types::Type::createSimpleTypeFromName("type_table_test_struct", 2);
+            auto copy = type;
+            handle = copy.getHandle();
+            EXPECT_LT(sizeBefore, typeTable.size());
+        }
+        EXPECT_EQ(sizeBefore, typeTable.size());
+        // handles are not reused, so caches keyed by them never see another type
+        auto recreated = types::Type::createSimpleTypeFromName("type_table_test_struct", 2);
+        EXPECT_NE(handle, recreated.getHandle());
+    }
+
+    TEST(Utils_Test, PathTrieMatchesIsSubPathOf) {
+        std::vector<fs::path> paths = { "/a/b/c.c", "/a/b/d/e.c", "/a/x.c", "/a/bb/y.c", "/z.c" };
+        PathTrie trie(paths);
+        EXPECT_EQ(paths.size(), trie.size());
+        EXPECT_TRUE(trie.contains("/a/x.c"));
+        EXPECT_FALSE(trie.contains("/a"));
+        for (const fs::path &directory : { "/a/b", "/a", "/", "/a/b/c.c", "/q" }) {
+            auto expected = CollectionUtils::filterOut(
+                Paths::pathsToSet(paths),
+                [&](const fs::path &path) { return !Paths::isSubPathOf(directory, path); });
+            EXPECT_EQ(expected, trie.getPathsUnder(directory)) << directory;
+        }
+        EXPECT_TRUE(trie.contains("/a/b/../x.c"));
+        EXPECT_EQ(CollectionUtils::FileSet({ "/a/b/c.c", "/a/b/d/e.c" }),
+                  trie.getPathsUnder("/a/./b/d/.."));
+    }
+
+    // decoration used before NameDecorator got a tokenizer
+    std::regex getCppOnlyKeywordsRegex() {
+        return std::regex{ "\\b(" + StringUtils::joinWith(NameDecorator::CPP_ONLY_KEYWORDS, "|") +
+                           ")\\b" };
+    }
+
+    const std::vector<std::string> DECORATED_NAMES = {
+        "class", "new", "delete_", "x", "this", "_new", "new2", "int", "and_eq", "and", "bool",
+        "struct", "\xc3\xa9new", "ns::new", "a.this->b", "1class", "Class", "", " ", "struct class *"
+    };
+
+    std::string getDecoratedFile(size_t repetitions) {
+        std::string generatedFile;
+        for (size_t i = 0; i < repetitions; ++i) {
+            for (const auto &name : DECORATED_NAMES) {
+                generatedFile += name;
+                generatedFile += i % 3 ? " " : ";\n";
+            }
+        }
+        return generatedFile;
+    }
+
+    TEST(Utils_Test, NameDecoratorMatchesRegexDecoration) {
+        const std::regex cppOnlyKeywordsRegex = getCppOnlyKeywordsRegex();
+        for (const auto &name : DECORATED_NAMES) {
+            EXPECT_EQ(std::regex_replace(name, cppOnlyKeywordsRegex, "$&_"),
+                      NameDecorator::decorate(name));
+        }
+        std::string generatedFile = getDecoratedFile(3);
+        EXPECT_EQ(std::regex_replace(generatedFile, cppOnlyKeywordsRegex, "$&_"),
+                  NameDecorator::decorate(generatedFile));
+    }
+
+    // benchmark, run it with --gtest_also_run_disabled_tests
+    TEST(Utils_Test, DISABLED_NameDecoratorBenchmark) {
+        const std::regex cppOnlyKeywordsRegex = getCppOnlyKeywordsRegex();
+        std::string generatedFile = getDecoratedFile(10000);
+
+        auto regexStart = std::chrono::steady_clock::now();
+        std::string expected = std::regex_replace(generatedFile, cppOnlyKeywordsRegex, "$&_");
+        auto decoratorStart = std::chrono::steady_clock::now();
+        std::string actual = NameDecorator::decorate(generatedFile);
+        auto decoratorEnd = std::chrono::steady_clock::now();
+        EXPECT_EQ(expected, actual);
+
+        using ms = std::chrono::duration<double, std::milli>;
+        RecordProperty("regex_ms", std::to_string(ms(decoratorStart - regexStart).count()));
+        RecordProperty("decorator_ms", std::to_string(ms(decoratorEnd - decoratorStart).count()));
+        EXPECT_LT(decoratorEnd - decoratorStart, decoratorStart - regexStart);
+    }
+
+    TEST(Utils_Test, SarifStackFrameMatchesRegex) {
+        const std::regex stackRegex(R"regex(\s+#(.*) in ([^ ]*) [(][^)]*[)] at ([^:]*):(\d+))regex");
+        std::vector<std::string> lines = {
+            "\t#100000123 in foo (a=1, b=0x0) at /path/to/source.c:42",
+            "    #2 in a in b (c) at d:7",
+            "    #1 in f (a) at b in g (c) at d:5",
+            "    #1 in f (a) at :5",
+            "#0 in main () at main.c:1",
+            "    #1 in f  (a) at b:5",
+            "    #1 in f (a)) at b:5",
+            "    #1 in f (a) at b:c:5",
+            "    #1 in f (a) at b:5x",
+            "    #1 in f (a) at b:",
+            "    # in f () at x:1"
+        };
+        for (const auto &line : lines) {
+            std::smatch match;
+            bool matched = std::regex_match(line, match, stackRegex);
+            auto frame = sarif::parseStackFrame(line);
+            ASSERT_EQ(matched, frame.has_value()) << line;
+            if (matched) {
+                EXPECT_EQ(match[2].str(), frame->function) << line;
+                EXPECT_EQ(match[3].str(), frame->file) << line;
+                EXPECT_EQ(std::stoi(match[4]), frame->line) << line;
+            }
+        }
+    }
+
+    TEST(Utils_Test, SarifStreamWriterCleansUpAndHashesReport) {
+        fs::path reportDir = fs::path(std::filesystem::temp_directory_path()) / "utbot_sarif_test";
+        fs::path reportPath = reportDir / "report.sarif.part";
+        fs::remove_all(reportDir);
+        {
+            sarif::SarifStreamWriter report(reportPath);
+            EXPECT_TRUE(fs::exists(reportPath));
+        }
+        EXPECT_FALSE(fs::exists(reportPath)) << "Unfinished report must be removed";
+
+        std::string hash;
+        {
+            sarif::SarifStreamWriter report(reportPath);
+            EXPECT_EQ(reportPath, report.close());
+            hash = report.contentHash();
+        }
+        ASSERT_TRUE(fs::exists(reportPath)) << "Closed report must be kept";
+        std::string content;
+        {
+            std::ifstream stream(reportPath.string());
+            content.assign(std::istreambuf_iterator<char>(stream), {});
+        }
+        EXPECT_EQ(HashUtils::contentHash(content), hash);
+        fs::remove_all(reportDir);
+    }
+
+    TEST(Utils_Test, SplitIntoChunks) {
+        testsgen::SourceCode source;
+        source.set_filepath("/a/test.cpp");
+        // "é" and "€" are 2 and 3 bytes long in UTF-8
+        std::string code = "ab\xc3\xa9" "cd\xe2\x82\xac" "efghij";
+        for (size_t maxChunkSize : { 0, 1, 2, 3, 4, 5, 100 }) {
+            std::vector<testsgen::SourceCode> chunks;
+            splitIntoChunks(source, code, maxChunkSize, [&](testsgen::SourceCode &&chunk) {
+                chunks.push_back(std::move(chunk));
+            });
+            std::vector<testsgen::SourceCode> streamedChunks;
+            std::istringstream stream(code);
+            splitIntoChunks(source, stream, maxChunkSize, [&](testsgen::SourceCode &&chunk) {
+                streamedChunks.push_back(std::move(chunk));
+            });
+
+            ASSERT_EQ(chunks.size(), streamedChunks.size()) << maxChunkSize;
+            std::string joined;
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                const auto &chunk = chunks[i];
+                EXPECT_EQ("/a/test.cpp", chunk.filepath());
+                EXPECT_EQ(joined.size(), chunk.codeoffset()) << maxChunkSize;
+                EXPECT_EQ(i + 1 < chunks.size(), chunk.hasmorechunks()) << maxChunkSize;
+                // a chunk is longer than the limit only if the limit is less than one character
+                if (maxChunkSize != 0 && chunk.code().size() > maxChunkSize) {
+                    EXPECT_LE(chunk.code().size(), 3) << maxChunkSize;
+                }
+                EXPECT_FALSE((static_cast<unsigned char>(chunk.code()[0]) & 0xC0) == 0x80)
+                    << "Chunk starts inside of character: " << maxChunkSize;
+                EXPECT_EQ(chunk.code(), streamedChunks[i].code()) << maxChunkSize;
+                EXPECT_EQ(chunk.hasmorechunks(), streamedChunks[i].hasmorechunks());
+                joined += chunk.code();
+            }
+            EXPECT_EQ(code, joined) << maxChunkSize;
+        }
+
+        std::vector<testsgen::SourceCode> emptyChunks;
+        std::istringstream emptyStream;
+        splitIntoChunks(source, emptyStream, 4, [&](testsgen::SourceCode &&chunk) {
+            emptyChunks.push_back(std::move(chunk));
+        });
+        ASSERT_EQ(1, emptyChunks.size());
+        EXPECT_TRUE(emptyChunks[0].code().empty());
+        EXPECT_FALSE(emptyChunks[0].hasmorechunks());
+    }
+
+    TEST(Utils_Test, LRUCacheDropsLeastRecentlyUsed) {
+        LRUCache<std::string, int> cache(2);
+        cache.put("a", 1);
+        cache.put("b", 2);
+        ASSERT_NE(nullptr, cache.get("a"));
+        cache.put("c", 3);
+        EXPECT_EQ(2, cache.size());
+        EXPECT_EQ(nullptr, cache.get("b"));
+        EXPECT_EQ(1, *cache.get("a"));
+        EXPECT_EQ(3, *cache.get("c"));
+
+        cache.put("a", 4);
+        cache.put("d", 5);
+        EXPECT_EQ(nullptr, cache.get("c"));
+        EXPECT_EQ(4, *cache.get("a"));
+    }
+
+    TEST(Utils_Test, CommandOptionsFollowChangedArguments) {
+        fs::path directory = "/project";
+        utbot::CompileCommand compileCommand({ "gcc", "-O2", "-Iinclude", "-c", "a.c", "-o", "a.o" },
+                                             directory, directory / "a.c");
+        compileCommand.transformArguments([](std::string &argument) {
+            if (argument == "-O2") {
+                argument = "-g";
+            }
+        });
+        compileCommand.setOptimizationLevel("-O0");
+        auto arguments = compileCommand.getCommandLine();
+        EXPECT_TRUE(CollectionUtils::contains(arguments, "-g"));
+        EXPECT_TRUE(CollectionUtils::contains(arguments, "-O0"));
+
+        compileCommand.erase("-O0");
+        compileCommand.setOptimizationLevel("-O1");
+        compileCommand.removeIncludeFlags();
+        arguments = compileCommand.getCommandLine();
+        EXPECT_EQ(1, std::count(arguments.begin(), arguments.end(), "-O1"));
+        EXPECT_FALSE(CollectionUtils::contains(arguments, "-Iinclude"));
+        // outputs that don't exist are kept relative to the command directory
+        EXPECT_EQ(fs::path("a.o"), compileCommand.getOutput());
+
+        utbot::LinkCommand linkCommand({ "gcc", "a.o", "-o", "a.out" }, directory);
+        EXPECT_TRUE(linkCommand.replace("a.out", "b.out"));
+        linkCommand.setOptimizationLevel("-O0");
+        arguments = linkCommand.getCommandLine();
+        EXPECT_EQ(fs::path("b.out"), linkCommand.getOutput());
+        EXPECT_TRUE(CollectionUtils::contains(arguments, "-O0"));
+    }
+
+    class UserProjectConfiguration_Test : public ::testing::Test {
+    protected:
+        fs::path projectDir =
+            fs::path(std::filesystem::temp_directory_path()) / "utbot_configuration_test";
+        fs::path buildDir = projectDir / "build" / "debug";
+
+        void SetUp() override {
+            fs::remove_all(projectDir);
+            fs::create_directories(buildDir);
+            FileSystemUtils::writeToFile(projectDir / "CMakeLists.txt", "add_executable(main main.c)");
+            FileSystemUtils::writeToFile(projectDir / "main.c", "int main() { return 0; }");
+            FileSystemUtils::writeToFile(projectDir / "lib.c", "int f() { return 0; }");
+        }
+
+        void TearDown() override {
+            fs::remove_all(projectDir);
+        }
+
+        nlohmann::json compileCommand(const std::string &source) const {
+            std::string object = source + ".o";
+            return { { "directory", projectDir.string() },
+                     { "file", source },
+                     { "arguments", { "gcc", "-c", source, "-o", object } } };
+        }
+
+        nlohmann::json linkCommand(const std::vector<std::string> &objects) const {
+            std::vector<std::string> arguments = { "gcc", "-o", "main" };
+            arguments.insert(arguments.end(), objects.begin(), objects.end());
+            return { { "directory", projectDir.string() },
+                     { "files", objects },
+                     { "arguments", arguments } };
+        }
+    };
+
+    TEST_F(UserProjectConfiguration_Test, CommandKeyIgnoresFlags) {
+        auto command = compileCommand("main.c");
+        auto rebuiltCommand = command;
+        rebuiltCommand["arguments"] = { "gcc", "-O2", "-c", "main.c", "-o", "main.c.o" };
+        EXPECT_EQ(UserProjectConfiguration::getCommandKey(command, false),
+                  UserProjectConfiguration::getCommandKey(rebuiltCommand, false));
+        EXPECT_NE(UserProjectConfiguration::getCommandKey(command, false),
+                  UserProjectConfiguration::getCommandKey(compileCommand("lib.c"), false));
+
+        auto archiveCommand = linkCommand({ "main.c.o" });
+        archiveCommand["arguments"] = { "ar", "qc", "libmain.a", "main.c.o" };
+        auto rebuiltArchiveCommand = archiveCommand;
+        rebuiltArchiveCommand["arguments"] = { "ar", "qc", "libmain.a", "main.c.o", "lib.c.o" };
+        auto ranlibCommand = archiveCommand;
+        ranlibCommand["arguments"] = { "ranlib", "libmain.a" };
+        EXPECT_EQ(UserProjectConfiguration::getCommandKey(archiveCommand, true),
+                  UserProjectConfiguration::getCommandKey(rebuiltArchiveCommand, true));
+        EXPECT_NE(UserProjectConfiguration::getCommandKey(archiveCommand, true),
+                  UserProjectConfiguration::getCommandKey(ranlibCommand, true));
+    }
+
+    TEST_F(UserProjectConfiguration_Test, InputsHashDependsOnProjectInputsOnly) {
+        std::vector<std::string> options = { "-DCMAKE_BUILD_TYPE=Debug", ".." };
+        std::string hash =
+            UserProjectConfiguration::getConfigurationInputsHash(projectDir, buildDir, options);
+
+        FileSystemUtils::writeToFile(projectDir / "main.c", "int main() { return 1; }");
+        FileSystemUtils::writeToFile(buildDir / "CMakeFiles" / "generated.cmake", "set(A 1)");
+        EXPECT_EQ(hash,
+                  UserProjectConfiguration::getConfigurationInputsHash(projectDir, buildDir, options));
+
+        EXPECT_NE(hash, UserProjectConfiguration::getConfigurationInputsHash(
+                            projectDir, buildDir, { "-DCMAKE_BUILD_TYPE=Release", ".." }));
+
+        FileSystemUtils::writeToFile(projectDir / ".git" / "hooks.cmake", "set(C 1)");
+        EXPECT_EQ(hash,
+                  UserProjectConfiguration::getConfigurationInputsHash(projectDir, buildDir, options));
+
+        FileSystemUtils::writeToFile(projectDir / "cmake" / "flags.cmake", "set(B 1)");
+        EXPECT_NE(hash,
+                  UserProjectConfiguration::getConfigurationInputsHash(projectDir, buildDir, options));
+    }
+
+    TEST_F(UserProjectConfiguration_Test, InputsHashDependsOnMakefilesWithoutCMake) {
+        std::vector<std::string> options = { ".." };
+        // cmake is run only for CMakeLists.txt next to the build directory
+        fs::path cmakeBuildDir = projectDir / "build";
+        std::string hash =
+            UserProjectConfiguration::getConfigurationInputsHash(projectDir, cmakeBuildDir, options);
+        FileSystemUtils::writeToFile(projectDir / "rules.mk", "CFLAGS = -O2");
+        EXPECT_EQ(hash, UserProjectConfiguration::getConfigurationInputsHash(projectDir,
+                                                                              cmakeBuildDir, options));
+
+        hash = UserProjectConfiguration::getConfigurationInputsHash(projectDir, buildDir, options);
+        FileSystemUtils::writeToFile(projectDir / "rules.mk", "CFLAGS = -O0");
+        EXPECT_NE(hash,
+                  UserProjectConfiguration::getConfigurationInputsHash(projectDir, buildDir, options));
+    }
+
+    TEST_F(UserProjectConfiguration_Test, MergeKeepsUnchangedAndDropsStaleCommands) {
+        fs::path compileCommandsPath = buildDir / "compile_commands.json";
+        fs::path linkCommandsPath = buildDir / "link_commands.json";
+        nlohmann::json previousCompileCommands = { compileCommand("main.c"), compileCommand("lib.c"),
+                                                   compileCommand("deleted.c") };
+        nlohmann::json previousLinkCommands = { linkCommand({ "main.c.o", "lib.c.o" }),
+                                                linkCommand({ "deleted.c.o" }) };
+        previousLinkCommands[1]["arguments"] = { "gcc", "-o", "deleted", "deleted.c.o" };
+
+        // only main.c was rebuilt
+        auto rebuiltCommand = compileCommand("main.c");
+        rebuiltCommand["arguments"] = { "gcc", "-O2", "-c", "main.c", "-o", "main.c.o" };
+        JsonUtils::writeJsonToFile(compileCommandsPath, nlohmann::json::array({ rebuiltCommand }));
+        JsonUtils::writeJsonToFile(linkCommandsPath, nlohmann::json::array());
+
+        UserProjectConfiguration::mergeCommandsJson(compileCommandsPath, previousCompileCommands, false);
+        UserProjectConfiguration::mergeCommandsJson(linkCommandsPath, previousLinkCommands, true);
+
+        auto compileCommands = JsonUtils::getJsonFromFile(compileCommandsPath);
+        ASSERT_EQ(2, compileCommands.size());
+        EXPECT_EQ(rebuiltCommand, compileCommands[0]);
+        EXPECT_EQ(previousCompileCommands[1], compileCommands[1]);
+
+        auto linkCommands = JsonUtils::getJsonFromFile(linkCommandsPath);
+        ASSERT_EQ(1, linkCommands.size());
+        EXPECT_EQ(previousLinkCommands[0], linkCommands[0]);
+    }
 }
@@ -391,6 +391,7 @@ export class Client {
             projectConfigRequest.setProjectcontext(projectContext);
             projectConfigRequest.setConfigmode(configMode);
             projectConfigRequest.setCmakeoptionsList(cmakeOptions);
+            projectConfigRequest.setIncrementalconfiguration(Prefs.useIncrementalConfiguration());
             try {
                 const response = this.testsService.configureProject(projectConfigRequest, this.metadata);
                 await this.handleServerResponse(response, progressKey, token, resolve, reject, responseHandler);
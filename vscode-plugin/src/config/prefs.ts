@@ -25,6 +25,7 @@ export class Prefs {
 
     public static BUILD_DIR_PREF = 'unittestbot.paths.buildDirectory';
     public static CMAKE_OPTIONS_PREF = 'unittestbot.paths.cmakeOptions';
+    public static INCREMENTAL_CONFIGURATION_PREF = 'unittestbot.paths.incrementalConfiguration';
     public static TESTS_DIR_PREF = 'unittestbot.paths.testsDirectory';
     public static SOURCE_DIRS_PREF = 'unittestbot.paths.sourceDirectories';
 
@@ -383,6 +384,10 @@ export class Prefs {
         return this.getAssetBase(Prefs.TEST_TIMEOUT_PREF, 0);
     }
 
+    public static useIncrementalConfiguration(): boolean {
+        return this.getAssetBase(Prefs.INCREMENTAL_CONFIGURATION_PREF, false);
+    }
+
     public static useDeterministicSearcher(): boolean {
         return this.getAssetBase(Prefs.DETERMINISTIC_SEARCHER_PREF, false);
     }
@@ -2,12 +2,11 @@ import * as vs from 'vscode';
 import { Client } from '../client/client';
 import { utbotUI } from '../interface/utbotUI';
 import { ExtensionLogger } from '../logger';
-import { StubsResponse } from '../proto-ts/testgen_pb';
 import { SourceCode } from '../proto-ts/util_pb';
 import { RequestTestsParams } from '../requests/params';
 import * as pathUtils from '../utils/pathUtils';
 import * as gen from './gen';
-import { DummyResponseHandler } from '../responses/responseHandler';
+import { StubsResponseHandler, verifyManifest } from '../responses/responseHandler';
 import { Prefs } from '../config/prefs';
 const { logger } = ExtensionLogger;
 
@@ -23,10 +22,11 @@ export async function stubProject(client: Client): Promise<void> {
         } catch (err) {
             return;
         }
-        const responseHandler = new DummyResponseHandler<StubsResponse>();
-        const stubs = await client.requestProjectStubs(params, responseHandler);
-        const stubsFiles = stubs.getStubsourcesList();
-        await handleStubsResponse(stubsFiles);
+        // stubs are streamed one by one, the completing response closes the stream
+        const responseHandler = new StubsResponseHandler();
+        const lastResponse = await client.requestProjectStubs(params, responseHandler);
+        await responseHandler.handle(lastResponse);
+        await handleStubsResponse(responseHandler.stubs);
     });
 }
 
@@ -39,5 +39,7 @@ async function handleStubsResponse(stubs: SourceCode[]): Promise<void> {
             logger.info(`Write mock file ${stub.getFilepath()} to ${localPath}`);
             await vs.workspace.fs.writeFile(mockfile, Buffer.from(stub.getCode()));
         }));
+    } else {
+        verifyManifest(stubs);
     }
 }
@@ -7,12 +7,16 @@ import {
     LineRequest,
     PredicateRequest,
     ProjectContext,
-    ProjectRequest
+    ProjectRequest,
+    TransferOptions
 } from "../proto-ts/testgen_pb";
 import { PredicateInfo, SourceInfo, ValidationType } from "../proto-ts/util_pb";
 import { RequestTestsParams } from "./params";
 
 export class Protos {
+    // responses larger than this are split into chunks by the server
+    private static readonly MAX_CHUNK_SIZE = 1 << 20;
+
     public static projectRequestByParams(params: RequestTestsParams): ProjectRequest {
         return this.projectRequest(
             params.projectPath,
@@ -41,6 +45,11 @@ export class Protos {
         projectInfo.setSettingscontext(Prefs.getSettingsContext());
         projectInfo.setSourcepathsList(srcPathsList);
         projectInfo.setSynchronizecode(synchronizeCode);
+        const transferOptions = new TransferOptions();
+        // server writes files directly to the workspace, so it is enough to receive their hashes
+        transferOptions.setSharedfilesystem(!synchronizeCode);
+        transferOptions.setMaxchunksize(Protos.MAX_CHUNK_SIZE);
+        projectInfo.setTransferoptions(transferOptions);
         projectInfo.setTargetpath(targetPath);
         return projectInfo;
     }
@@ -9,6 +9,8 @@ import { ExtensionLogger } from "../logger";
 import { TestsRunner } from "../runner/testsRunner";
 import {Uri} from "vscode";
 import * as messages from "../config/notificationMessages";
+import { FSUtils } from "../utils/fsUtils";
+import { SourceCode } from "../proto-ts/util_pb";
 
 const { logger } = ExtensionLogger;
 
@@ -18,13 +20,52 @@ export interface ResponseHandler<T extends SomeResponse> {
     handle(response: T): Promise<void>;
 }
 
+/**
+ * Joins chunks of files that the server splits into several responses,
+ * see TransferOptions.maxChunkSize.
+ */
+export class SourceChunksAssembler {
+    private readonly pendingChunks = new Map<string, string[]>();
+
+    /**
+     * Returns the sources whose last chunk has arrived, with the code of the whole file.
+     */
+    public complete(sources: SourceCode[]): SourceCode[] {
+        const completed: SourceCode[] = [];
+        for (const source of sources) {
+            const chunks = this.pendingChunks.get(source.getFilepath()) ?? [];
+            chunks.push(source.getCode());
+            if (source.getHasmorechunks()) {
+                this.pendingChunks.set(source.getFilepath(), chunks);
+                continue;
+            }
+            this.pendingChunks.delete(source.getFilepath());
+            source.setCode(chunks.join(''));
+            source.setCodeoffset(0);
+            completed.push(source);
+        }
+        return completed;
+    }
+}
+
 export class DummyResponseHandler<T extends SomeResponse> implements ResponseHandler<T> {
     public async handle(_response: T): Promise<void> {
         return;
     }
 }
 
+export class StubsResponseHandler implements ResponseHandler<StubsResponse> {
+    private readonly chunks = new SourceChunksAssembler();
+    public readonly stubs: SourceCode[] = [];
+
+    public async handle(response: StubsResponse): Promise<void> {
+        this.stubs.push(...this.chunks.complete(response.getStubsourcesList()));
+    }
+}
+
 export class TestsResponseHandler implements ResponseHandler<TestsResponse> {
+    private readonly chunks = new SourceChunksAssembler();
+
     constructor(
         private readonly client: Client,
         private readonly testsRunner: TestsRunner,
@@ -32,7 +73,7 @@ export class TestsResponseHandler implements ResponseHandler<TestsResponse> {
     }
 
     public async handle(response: TestsResponse): Promise<void> {
-        const testsSourceList = response.getTestsourcesList();
+        const testsSourceList = this.chunks.complete(response.getTestsourcesList());
 
         // Delete/backup old info
         for (const test of testsSourceList) {
@@ -53,7 +94,7 @@ export class TestsResponseHandler implements ResponseHandler<TestsResponse> {
             //  do not write files for local scenario - server did it
             const stubs = response.getStubs();
             if (stubs) {
-                const stubsFiles = stubs.getStubsourcesList();
+                const stubsFiles = this.chunks.complete(stubs.getStubsourcesList());
                 for (const stub of stubsFiles) {
                     const localPath = pathUtils.substituteLocalPath(stub.getFilepath());
                     logger.info(`Write stub file ${stub.getFilepath()} to ${localPath}`);
@@ -64,6 +105,8 @@ export class TestsResponseHandler implements ResponseHandler<TestsResponse> {
                 const localPath = pathUtils.substituteLocalPath(test.getFilepath());
                 await vs.workspace.fs.writeFile(vs.Uri.file(localPath), Buffer.from(test.getCode()));
             }
+        } else {
+            verifyManifest(testsSourceList);
         }
 
         // Show and log the results in UI
@@ -108,6 +151,18 @@ export class TestsResponseHandler implements ResponseHandler<TestsResponse> {
     }
 }
 
+/**
+ * Checks files written by the server against hashes sent instead of their code.
+ */
+export function verifyManifest(sources: SourceCode[]): void {
+    for (const source of sources) {
+        const hash = source.getContenthash();
+        if (hash.length > 0 && !FSUtils.matchesContentHash(source.getFilepath(), hash)) {
+            logger.warn(`File ${source.getFilepath()} differs from the one generated by server`);
+        }
+    }
+}
+
 function isSarifReportFile(testfile: string): boolean {
     return testfile.endsWith("project_code_analysis.sarif");
 }
@@ -138,13 +193,15 @@ function isTestFileSourceFile(localpath: string): boolean {
 }
 
 export class SnippetResponseHandler implements ResponseHandler<TestsResponse> {
+    private readonly chunks = new SourceChunksAssembler();
+
     constructor(
         private readonly testsRunner: TestsRunner) {
     }
 
     public async handle(response: TestsResponse): Promise<void> {
         this.testsRunner.hideTestResultsAndCoverage();
-        const testsSourcesList = response.getTestsourcesList();
+        const testsSourcesList = this.chunks.complete(response.getTestsourcesList());
         if (testsSourcesList.length === 0) {
             return;
         }
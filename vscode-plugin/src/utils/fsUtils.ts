@@ -46,4 +46,34 @@ export namespace FSUtils {
 
         return result;
     }
+
+    /**
+     * Hash of file content computed the same way as on the server:
+     * 64-bit FNV-1a printed as 16 lowercase hex digits.
+     */
+    export function contentHash(content: Uint8Array): string {
+        // 64-bit arithmetic in 16-bit limbs, offset basis is 0xcbf29ce484222325
+        let h0 = 0x2325, h1 = 0x8422, h2 = 0x9ce4, h3 = 0xcbf2;
+        for (let i = 0; i < content.length; i++) {
+            h0 ^= content[i];
+            // multiply by prime 0x100000001b3 = 2^40 + 0x1b3
+            const t0 = h0 * 0x1b3;
+            const t1 = h1 * 0x1b3 + (t0 >>> 16);
+            const t2 = h2 * 0x1b3 + (h0 << 8) + (t1 >>> 16);
+            const t3 = h3 * 0x1b3 + (h1 << 8) + (t2 >>> 16);
+            h0 = t0 & 0xffff;
+            h1 = t1 & 0xffff;
+            h2 = t2 & 0xffff;
+            h3 = t3 & 0xffff;
+        }
+        return [h3, h2, h1, h0].map(limb => ("000" + limb.toString(16)).slice(-4)).join("");
+    }
+
+    /**
+     * Checks file written by the server against the hash from the server's manifest.
+     */
+    export function matchesContentHash(path: string, hash: string): boolean {
+        const parsedPath = vs.Uri.file(path).fsPath;
+        return fs.existsSync(parsedPath) && contentHash(fs.readFileSync(parsedPath)) === hash;
+    }
 }